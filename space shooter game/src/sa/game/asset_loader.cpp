@@ -0,0 +1,170 @@
+#include "asset_loader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "asset_pack.h"
+#include "resource_manager.h"
+#include "texture_cache.h"
+
+AssetLoader::AssetLoader(unsigned int workers)
+    : nextWork(0), workerCount(workers)
+{
+    if (this->workerCount == 0)
+    {
+        unsigned int cores = std::thread::hardware_concurrency();
+        this->workerCount = cores > 1 ? cores - 1 : 1;
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    for (std::thread &thread : this->threads)
+        if (thread.joinable())
+            thread.join();
+}
+
+void AssetLoader::QueueShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name)
+{
+    struct Sources {
+        std::string Vertex, Fragment, Geometry;
+    };
+    auto sources = std::make_shared<Sources>();
+    std::string vFile = vShaderFile, fFile = fShaderFile, gFile = gShaderFile ? gShaderFile : "";
+    this->queue([=]() {
+        sources->Vertex = AssetPack::LoadText(vFile.c_str());
+        sources->Fragment = AssetPack::LoadText(fFile.c_str());
+        if (!gFile.empty())
+            sources->Geometry = AssetPack::LoadText(gFile.c_str());
+    }, [=]() {
+        ResourceManager::LoadShaderFromSource(sources->Vertex.c_str(), sources->Fragment.c_str(),
+                                              gFile.empty() ? nullptr : sources->Geometry.c_str(), name);
+    });
+}
+
+void AssetLoader::QueueTexture(const char *file, bool alpha, std::string name, bool mipmaps)
+{
+    // El mismo archivo encolado otra vez no se vuelve a leer: su subida comparte la textura por clave
+    std::string path = file;
+    std::shared_ptr<DecodedImage> &image = this->queuedImages[path + (alpha ? ":rgba" : ":rgb") + (mipmaps ? ":mips" : "")];
+    std::function<void()> work;
+    if (!image)
+    {
+        image = std::make_shared<DecodedImage>();
+        std::shared_ptr<DecodedImage> target = image;
+        work = [=]() {
+            TextureCache::Decode(path.c_str(), alpha, 0, mipmaps, target->Image);
+        };
+    }
+    std::shared_ptr<DecodedImage> source = image;
+    this->queue(work, [=]() {
+        const CachedImage &pixels = source->Image;
+        ResourceManager::LoadTextureFromMemory(pixels.Data, pixels.Width, pixels.Height, alpha, name, pixels.Key, pixels.Levels, pixels.Channels);
+    });
+}
+
+void AssetLoader::QueueAtlasTexture(const char *file, std::string name)
+{
+    std::string path = file;
+    std::shared_ptr<DecodedImage> &image = this->queuedImages[path + ":atlas"];
+    std::function<void()> work;
+    if (!image)
+    {
+        image = std::make_shared<DecodedImage>();
+        std::shared_ptr<DecodedImage> target = image;
+        work = [=]() {
+            target->Failed = !TextureCache::Decode(path.c_str(), true, 4, false, target->Image);
+        };
+    }
+    std::shared_ptr<DecodedImage> source = image;
+    this->queue(work, [=]() {
+        if (source->Failed)
+        {
+            std::cout << "ERROR::TEXTURE: Failed to load " << path << std::endl;
+            return;
+        }
+        // La primera subida cede los píxeles al ResourceManager; las repetidas solo añaden su nombre
+        CachedImage &pixels = source->Image;
+        ResourceManager::QueueAtlasImage(name, pixels.Width, pixels.Height, pixels.Release(), pixels.Key);
+    });
+}
+
+void AssetLoader::QueueLevel(const char *file, GameLevel *level, unsigned int levelWidth, unsigned int levelHeight)
+{
+    auto tiles = std::make_shared<std::vector<std::vector<unsigned int>>>();
+    std::string path = file;
+    this->queue([=]() {
+        GameLevel::ParseTiles(path.c_str(), *tiles);
+    }, [=]() {
+        // Build consulta texturas del ResourceManager, por eso va en el hilo principal
+        level->Build(*tiles, levelWidth, levelHeight);
+    });
+}
+
+void AssetLoader::QueueMainThread(std::function<void()> task)
+{
+    this->queue(nullptr, task);
+}
+
+void AssetLoader::queue(std::function<void()> work, std::function<void()> upload)
+{
+    std::unique_ptr<Job> job(new Job());
+    job->Work = work;
+    job->Upload = upload;
+    job->Done = !work;
+    this->jobs.push_back(std::move(job));
+}
+
+void AssetLoader::Run(LoadProgressCallback progress)
+{
+    auto start = std::chrono::steady_clock::now();
+    unsigned int workers = std::min<unsigned int>(this->workerCount, static_cast<unsigned int>(this->jobs.size()));
+    for (unsigned int i = 0; i < workers; ++i)
+        this->threads.emplace_back(&AssetLoader::workerLoop, this);
+
+    // Subidas en orden de encolado; si el trabajo previo aún no terminó se espera a los hilos
+    for (unsigned int i = 0; i < this->jobs.size(); ++i)
+    {
+        Job &job = *this->jobs[i];
+        if (!job.Done)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->workDone.wait(lock, [&job]() { return job.Done.load(); });
+        }
+        if (job.Upload)
+            job.Upload();
+        if (progress)
+            progress(static_cast<float>(i + 1) / this->jobs.size());
+    }
+
+    for (std::thread &thread : this->threads)
+        thread.join();
+    this->threads.clear();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "LOADER: " << this->jobs.size() << " jobs on " << workers << " worker thread(s) in "
+              << elapsed.count() << " ms" << std::endl;
+    this->jobs.clear();
+    this->queuedImages.clear();
+    this->nextWork = 0;
+}
+
+// Cada hilo toma el siguiente trabajo pendiente hasta agotarlos
+void AssetLoader::workerLoop()
+{
+    while (true)
+    {
+        unsigned int index = this->nextWork++;
+        if (index >= this->jobs.size())
+            return;
+        Job &job = *this->jobs[index];
+        if (job.Done)
+            continue;
+        job.Work();
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            job.Done = true;
+        }
+        this->workDone.notify_all();
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "game_level.h"
+#include "texture_cache.h"
+
+// Recibe el avance de la carga entre 0 y 1 (p. ej. para dibujar una pantalla de carga)
+typedef std::function<void(float progress)> LoadProgressCallback;
+
+// Cargador de recursos en dos fases: los hilos de trabajo leen archivos, decodifican PNG
+// y parsean niveles en paralelo; el hilo principal solo sube a GL y enlaza programas.
+// Las subidas se ejecutan en el mismo orden en que se encolaron los trabajos.
+class AssetLoader
+{
+public:
+
+    AssetLoader(unsigned int workers = 0); // 0: un hilo por núcleo menos el principal
+    ~AssetLoader();
+    void QueueShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name);
+    void QueueTexture(const char *file, bool alpha, std::string name, bool mipmaps = false);
+    void QueueAtlasTexture(const char *file, std::string name);
+    void QueueLevel(const char *file, GameLevel *level, unsigned int levelWidth, unsigned int levelHeight);
+    // trabajo solo de hilo principal (GL), ejecutado tras todos los encolados antes
+    void QueueMainThread(std::function<void()> task);
+    // arranca los hilos y ejecuta las subidas hasta terminar, avisando del progreso tras cada una
+    void Run(LoadProgressCallback progress = nullptr);
+
+private:
+
+    struct Job {
+        std::function<void()> Work;   // hilo de trabajo (puede estar vacío)
+        std::function<void()> Upload; // hilo principal
+        std::atomic<bool>     Done;
+    };
+    // imagen decodificada en un hilo; se comparte entre los trabajos que piden el mismo archivo
+    struct DecodedImage {
+        CachedImage Image;
+        bool        Failed = false;
+    };
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::map<std::string, std::shared_ptr<DecodedImage>> queuedImages;
+    std::vector<std::thread> threads;
+    std::atomic<unsigned int> nextWork;
+    std::mutex mutex;
+    std::condition_variable workDone;
+    unsigned int workerCount;
+    void queue(std::function<void()> work, std::function<void()> upload);
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,187 @@
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "resource_id.h"
+
+// Hora de modificación de un archivo del disco; false si no existe
+static bool fileTime(const char *file, std::int64_t &time)
+{
+    std::error_code error;
+    std::filesystem::file_time_type stamp = std::filesystem::last_write_time(file, error);
+    time = static_cast<std::int64_t>(stamp.time_since_epoch().count());
+    return !error;
+}
+
+MappedFile AssetPack::mapping;
+std::int64_t AssetPack::mappingTime = 0;
+const PackEntry *AssetPack::entries = nullptr;
+std::uint32_t AssetPack::entryCount = 0;
+
+bool MappedFile::Open(const char *file, bool sequential)
+{
+    this->Close();
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    GetFileSizeEx(handle, &size);
+    HANDLE map = size.QuadPart > 0 ? CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    void *view = map ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!view)
+    {
+        if (map)
+            CloseHandle(map);
+        CloseHandle(handle);
+        return false;
+    }
+    this->fileHandle = handle;
+    this->mappingHandle = map;
+    this->data = static_cast<const unsigned char*>(view);
+    this->size = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void *view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // el mapeo sigue siendo válido sin el descriptor
+    if (view == MAP_FAILED)
+        return false;
+    if (sequential)
+    {
+        // Pide al kernel que lo lea entero en secuencia en lugar de fallo de página a fallo de página
+        madvise(view, info.st_size, MADV_SEQUENTIAL);
+        madvise(view, info.st_size, MADV_WILLNEED);
+    }
+    this->data = static_cast<const unsigned char*>(view);
+    this->size = static_cast<std::size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!this->data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(this->data);
+    CloseHandle(this->mappingHandle);
+    CloseHandle(this->fileHandle);
+    this->mappingHandle = this->fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(this->data), this->size);
+#endif
+    this->data = nullptr;
+    this->size = 0;
+}
+
+// Mapea el paquete completo y valida la cabecera y el índice
+bool AssetPack::Mount(const char *file)
+{
+    Unmount();
+    if (!mapping.Open(file, true))
+        return false;
+    const PackHeader *header = reinterpret_cast<const PackHeader*>(mapping.Data());
+    if (mapping.Size() < sizeof(PackHeader) || std::memcmp(header->Magic, PACK_MAGIC, 4) != 0 || header->Version != PACK_VERSION
+        || mapping.Size() < sizeof(PackHeader) + header->EntryCount * sizeof(PackEntry))
+    {
+        std::cout << "ERROR::PACK: Invalid asset pack " << file << std::endl;
+        Unmount();
+        return false;
+    }
+    entries = reinterpret_cast<const PackEntry*>(mapping.Data() + sizeof(PackHeader));
+    entryCount = header->EntryCount;
+    fileTime(file, mappingTime);
+    std::cout << "PACK: mounted " << file << " (" << entryCount << " files, " << mapping.Size() / 1024 << " KiB)" << std::endl;
+    return true;
+}
+
+void AssetPack::Unmount()
+{
+    mapping.Close();
+    mappingTime = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+bool AssetPack::IsMounted()
+{
+    return mapping.Data() != nullptr;
+}
+
+// Búsqueda binaria en el índice ordenado por hash; nullptr si no hay paquete o no está
+const PackEntry *AssetPack::find(const char *path)
+{
+    if (!mapping.Data())
+        return nullptr;
+    std::uint64_t hash = ResourceID(path).Hash;
+    const PackEntry *end = entries + entryCount;
+    const PackEntry *entry = std::lower_bound(entries, end, hash,
+        [](const PackEntry &e, std::uint64_t key) { return e.Hash < key; });
+    if (entry != end && entry->Hash == hash && entry->Offset + entry->Size <= mapping.Size())
+        return entry;
+    return nullptr;
+}
+
+bool AssetPack::Load(const char *path, AssetView &view)
+{
+    view.Storage.clear();
+    if (const PackEntry *entry = find(path))
+    {
+        view.Data = mapping.Data() + entry->Offset;
+        view.Size = static_cast<std::size_t>(entry->Size);
+        return true;
+    }
+    // Sin paquete (o archivo fuera de él): lectura normal del disco
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        view.Data = nullptr;
+        view.Size = 0;
+        return false;
+    }
+    view.Storage.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    view.Data = view.Storage.data();
+    view.Size = view.Storage.size();
+    return true;
+}
+
+std::string AssetPack::LoadText(const char *path)
+{
+    AssetView view;
+    if (!Load(path, view))
+        return std::string();
+    return std::string(reinterpret_cast<const char*>(view.Data), view.Size);
+}
+
+bool AssetPack::Timestamp(const char *path, std::int64_t &time)
+{
+    if (find(path))
+    {
+        time = mappingTime;
+        return true;
+    }
+    return fileTime(path, time);
+}
@@ -0,0 +1,89 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Formato del paquete de recursos (little endian):
+//   PackHeader | PackEntry[EntryCount] ordenadas por Hash | datos de cada archivo (alineados a 16)
+// Hash es el FNV-1a de 64 bits de la ruta relativa con '/' (el mismo que ResourceID).
+const char          PACK_MAGIC[4] = { 'S', 'A', 'P', 'K' };
+const std::uint32_t PACK_VERSION = 1;
+const std::uint64_t PACK_ALIGNMENT = 16;
+
+struct PackHeader {
+    char          Magic[4];
+    std::uint32_t Version;
+    std::uint32_t EntryCount;
+    std::uint32_t Reserved;
+};
+
+struct PackEntry {
+    std::uint64_t Hash;
+    std::uint64_t Offset; // desde el inicio del archivo
+    std::uint64_t Size;
+};
+
+// Contenido de un recurso: apunta al paquete mapeado en memoria o, si no está ahí, a Storage
+struct AssetView {
+    const unsigned char       *Data = nullptr;
+    std::size_t                Size = 0;
+    std::vector<unsigned char> Storage;
+
+    AssetView() { }
+    AssetView(const AssetView &) = delete;
+    AssetView &operator=(const AssetView &) = delete;
+};
+
+// Archivo completo mapeado en memoria de solo lectura (mmap / MapViewOfFile)
+class MappedFile
+{
+public:
+
+    MappedFile() : data(nullptr), size(0) { }
+    ~MappedFile() { this->Close(); }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    // sequential: avisa al sistema de que se leerá entero y en orden
+    bool Open(const char *file, bool sequential = false);
+    void Close();
+    const unsigned char *Data() const { return this->data; }
+    std::size_t          Size() const { return this->size; }
+
+private:
+
+    const unsigned char *data;
+    std::size_t          size;
+#ifdef _WIN32
+    void *fileHandle = nullptr, *mappingHandle = nullptr;
+#endif
+};
+
+// Paquete montado con mmap: las lecturas no abren archivos sueltos, solo devuelven punteros
+// a la vista mapeada. Sin paquete montado se lee del disco como antes.
+class AssetPack
+{
+public:
+
+    static bool Mount(const char *file);
+    static void Unmount();
+    static bool IsMounted();
+    // busca path en el paquete; si no está, lo lee del disco. false si no existe en ninguno
+    static bool Load(const char *path, AssetView &view);
+    // igual que Load para archivos de texto (shaders, niveles); vacío si no existe
+    static std::string LoadText(const char *path);
+    // hora de modificación del origen de path (el paquete si está en él); false si no existe
+    static bool Timestamp(const char *path, std::int64_t &time);
+
+private:
+
+    AssetPack() { }
+    static MappedFile       mapping;
+    static std::int64_t     mappingTime;  // el epoch del reloj de archivos es arbitrario: puede ser negativa
+    static const PackEntry *entries;
+    static std::uint32_t    entryCount;
+    static const PackEntry *find(const char *path);
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef BAKED_FONT_H
+#define BAKED_FONT_H
+#include <cstdint>
+#include <string>
+
+#include "glyph_rasterizer.h"
+
+// Fuente horneada por font_baker: cabecera, glifos y la página del atlas (AtlasSize^2 bytes, GL_RED)
+// con cada glifo en su celda, en el mismo orden de celdas que usa TextRenderer.
+// TextRenderer la carga con una lectura y una subida de textura, sin FreeType.
+const char          BAKED_FONT_MAGIC[4] = { 'S', 'A', 'F', 'N' };
+const std::uint32_t BAKED_FONT_VERSION = 1;
+
+struct BakedFontHeader {
+    char          Magic[4];
+    std::uint32_t Version;
+    std::uint32_t Mode;       // TextMode
+    std::uint32_t FontSize;
+    std::uint32_t AtlasSize;
+    std::uint32_t CellWidth, CellHeight;
+    std::uint32_t GlyphCount;
+};
+
+struct BakedGlyph {
+    std::uint32_t Codepoint;
+    std::uint32_t Cell;
+    std::int32_t  Width, Height;
+    std::int32_t  BearingX, BearingY;
+    std::uint32_t Advance;    // 26.6
+};
+
+// resources/fonts/OCRAEXT.TTF, 24, TEXT_SDF -> resources/fonts/OCRAEXT_24_sdf.font
+inline std::string BakedFontPath(const std::string &font, unsigned int fontSize, TextMode mode)
+{
+    std::string::size_type dot = font.find_last_of('.');
+    std::string::size_type slash = font.find_last_of('/');
+    std::string base = dot != std::string::npos && (slash == std::string::npos || dot > slash) ? font.substr(0, dot) : font;
+    return base + "_" + std::to_string(fontSize) + (mode == TEXT_SDF ? "_sdf" : "_bitmap") + ".font";
+}
+
+#endif
@@ -0,0 +1,226 @@
+#include "box_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define BOX_KERNEL_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BOX_KERNEL_SSE
+#endif
+
+// Relleno: una caja en (FAR, FAR) queda a distancia infinita de cualquier círculo
+static const unsigned int BOX_LANES = 8;
+static const float FAR = 1e30f;
+// dos impactos a menos de esta distancia (en píxeles) del recorrido cuentan como simultáneos
+static const float SWEEP_TOLERANCE = 0.01f;
+
+static inline unsigned int lowestBit(std::uint32_t mask)
+{
+    unsigned int bit = 0;
+    for (; !(mask & 1u); mask >>= 1)
+        ++bit;
+    return bit;
+}
+
+static inline float clampf(float value, float low, float high)
+{
+    value = value < low ? low : value;
+    return value > high ? high : value;
+}
+
+void BoxBatch::Clear()
+{
+    this->count = 0;
+    this->MinX.clear();
+    this->MinY.clear();
+    this->MaxX.clear();
+    this->MaxY.clear();
+    this->times.clear();
+}
+
+void BoxBatch::Add(glm::vec2 position, glm::vec2 size)
+{
+    // la caja ocupa la primera plaza de relleno; si no queda, se añade un bloque nuevo de 8
+    if (this->count == this->MinX.size())
+    {
+        std::size_t padded = this->MinX.size() + BOX_LANES;
+        this->MinX.resize(padded, FAR);
+        this->MinY.resize(padded, FAR);
+        this->MaxX.resize(padded, FAR);
+        this->MaxY.resize(padded, FAR);
+    }
+    this->MinX[this->count] = position.x;
+    this->MinY[this->count] = position.y;
+    this->MaxX[this->count] = position.x + size.x;
+    this->MaxY[this->count] = position.y + size.y;
+    ++this->count;
+    this->times.resize(this->count);
+}
+
+int BoxBatch::Test(glm::vec2 center, float radius, std::vector<std::uint32_t> &hits, glm::vec2 &normal) const
+{
+    hits.assign((this->count + 31) / 32, 0u);
+    normal = glm::vec2(0.0f);
+    unsigned int padded = static_cast<unsigned int>(this->MinX.size());
+    float radius2 = radius * radius;
+    // punto más cercano de cada caja = centro recortado a la caja; choque si está a menos del radio
+#if defined(BOX_KERNEL_AVX)
+    __m256 cx = _mm256_set1_ps(center.x), cy = _mm256_set1_ps(center.y), r2 = _mm256_set1_ps(radius2);
+    for (unsigned int i = 0; i < padded; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cx, _mm256_loadu_ps(&this->MinX[i])), _mm256_loadu_ps(&this->MaxX[i])), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cy, _mm256_loadu_ps(&this->MinY[i])), _mm256_loadu_ps(&this->MaxY[i])), cy);
+        __m256 distance2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(distance2, r2, _CMP_LT_OQ)));
+        if (mask)
+            hits[i / 32] |= mask << (i % 32);
+    }
+#elif defined(BOX_KERNEL_SSE)
+    __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), r2 = _mm_set1_ps(radius2);
+    for (unsigned int i = 0; i < padded; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, _mm_loadu_ps(&this->MinX[i])), _mm_loadu_ps(&this->MaxX[i])), cx);
+        __m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, _mm_loadu_ps(&this->MinY[i])), _mm_loadu_ps(&this->MaxY[i])), cy);
+        __m128 distance2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(distance2, r2)));
+        if (mask)
+            hits[i / 32] |= mask << (i % 32);
+    }
+#else
+    for (unsigned int i = 0; i < padded; ++i)
+    {
+        float dx = clampf(center.x, this->MinX[i], this->MaxX[i]) - center.x;
+        float dy = clampf(center.y, this->MinY[i], this->MaxY[i]) - center.y;
+        if (dx * dx + dy * dy < radius2)
+            hits[i / 32] |= 1u << (i % 32);
+    }
+#endif
+    // las plazas de relleno nunca chocan, así que el primer bit es la primera caja real
+    for (unsigned int word = 0; word < hits.size(); ++word)
+    {
+        if (!hits[word])
+            continue;
+        unsigned int first = word * 32 + lowestBit(hits[word]);
+        // una sola raíz, y solo para la caja que se devuelve
+        glm::vec2 closest(clampf(center.x, this->MinX[first], this->MaxX[first]),
+                          clampf(center.y, this->MinY[first], this->MaxY[first]));
+        glm::vec2 difference = center - closest;
+        float length2 = glm::dot(difference, difference);
+        if (length2 > 0.0f)
+            normal = difference / std::sqrt(length2);
+        return static_cast<int>(first);
+    }
+    return -1;
+}
+
+int BoxBatch::Sweep(glm::vec2 center, float radius, glm::vec2 displacement, std::vector<std::uint32_t> &hits, float &time, glm::vec2 &normal)
+{
+    glm::vec2 unused;
+    this->Test(center + displacement * 0.5f, radius + glm::length(displacement) * 0.5f, hits, unused);
+    // la prueba exacta solo para las cajas que toca el recorrido; se guarda el instante de cada una
+    int first = -1;
+    time = 1.0f;
+    float distance = glm::length(displacement);
+    for (unsigned int word = 0; word < hits.size(); ++word)
+    {
+        std::uint32_t impacts = 0;
+        for (std::uint32_t bits = hits[word]; bits; bits &= bits - 1)
+        {
+            unsigned int i = word * 32 + lowestBit(bits);
+            float t;
+            glm::vec2 n;
+            if (!SweepCircle(center, radius, displacement, glm::vec2(this->MinX[i], this->MinY[i]), glm::vec2(this->MaxX[i], this->MaxY[i]), t, n))
+                continue;
+            this->times[i] = t;
+            impacts |= 1u << (i % 32);
+            if (first < 0 || t < time)
+            {
+                first = static_cast<int>(i);
+                time = t;
+                normal = n;
+            }
+        }
+        hits[word] = impacts;
+    }
+    // se quedan en hits las que chocan en el mismo instante (p.ej. dos ladrillos contiguos)
+    for (unsigned int word = 0; word < hits.size(); ++word)
+        for (std::uint32_t bits = hits[word]; bits; bits &= bits - 1)
+        {
+            unsigned int i = word * 32 + lowestBit(bits);
+            if ((this->times[i] - time) * distance > SWEEP_TOLERANCE)
+                hits[word] &= ~(1u << (i % 32));
+        }
+    return first;
+}
+
+bool SweepCircle(glm::vec2 center, float radius, glm::vec2 displacement, glm::vec2 min, glm::vec2 max, float &time, glm::vec2 &normal)
+{
+    // si ya la toca al principio no cuenta como impacto
+    glm::vec2 closest(clampf(center.x, min.x, max.x), clampf(center.y, min.y, max.y));
+    glm::vec2 difference = center - closest;
+    if (glm::dot(difference, difference) < radius * radius)
+        return false;
+    // rayo contra la caja ensanchada por el radio (método de los planos)
+    float enter = -1e30f, exit = 1e30f;
+    int axis = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        float low = min[i] - radius, high = max[i] + radius;
+        if (displacement[i] == 0.0f)
+        {
+            if (center[i] < low || center[i] > high)
+                return false;
+            continue;
+        }
+        float t0 = (low - center[i]) / displacement[i], t1 = (high - center[i]) / displacement[i];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        if (t0 > enter)
+        {
+            enter = t0;
+            axis = i;
+        }
+        exit = std::min(exit, t1);
+    }
+    if (enter > exit || exit < 0.0f || enter > 1.0f)
+        return false;
+    enter = std::max(enter, 0.0f);
+    // en las esquinas la caja ensanchada es redondeada: rayo contra el círculo de la esquina
+    glm::vec2 point = center + displacement * enter;
+    bool outsideX = point.x < min.x || point.x > max.x, outsideY = point.y < min.y || point.y > max.y;
+    if (outsideX && outsideY)
+    {
+        glm::vec2 corner(point.x < min.x ? min.x : max.x, point.y < min.y ? min.y : max.y);
+        glm::vec2 m = center - corner;
+        float a = glm::dot(displacement, displacement);
+        float b = glm::dot(m, displacement);
+        float c = glm::dot(m, m) - radius * radius;
+        float discriminant = b * b - a * c;
+        if (b >= 0.0f || discriminant < 0.0f) // se aleja de la esquina o no la alcanza
+            return false;
+        float t = (-b - std::sqrt(discriminant)) / a;
+        if (t > 1.0f)
+            return false;
+        time = std::max(t, 0.0f);
+        normal = (center + displacement * time - corner) / radius;
+        return true;
+    }
+    time = enter;
+    normal = glm::vec2(0.0f);
+    normal[axis] = displacement[axis] > 0.0f ? -1.0f : 1.0f;
+    return true;
+}
+
+const char *BoxBatch::Kernel()
+{
+#if defined(BOX_KERNEL_AVX)
+    return "AVX";
+#elif defined(BOX_KERNEL_SSE)
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
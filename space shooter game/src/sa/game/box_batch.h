@@ -0,0 +1,43 @@
+#ifndef BOX_BATCH_H
+#define BOX_BATCH_H
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Cajas alineadas con los ejes en estructura de arrays, para probar un círculo contra 8 (AVX)
+// o 4 (SSE) cajas por iteración comparando distancias al cuadrado, sin raíces.
+// Los arrays se rellenan hasta múltiplo de 8 con cajas inalcanzables, así no hay bucle de cola.
+// No usa GL, por eso también lo enlaza la herramienta collision_benchmark.
+class BoxBatch
+{
+public:
+
+    std::vector<float> MinX, MinY, MaxX, MaxY;
+
+    BoxBatch() : count(0) { }
+    unsigned int Count() const { return this->count; }
+    void Clear();
+    void Add(glm::vec2 position, glm::vec2 size);
+    // pone a 1 en hits el bit i (palabra i / 32) de cada caja que solapa el círculo y devuelve
+    // la primera, o -1; normal es la normal de contacto de esa caja (de la caja hacia el centro)
+    int Test(glm::vec2 center, float radius, std::vector<std::uint32_t> &hits, glm::vec2 &normal) const;
+    // prueba continua: la primera caja que el círculo empieza a tocar al desplazarse displacement,
+    // o -1; time es la fracción del desplazamiento en ese momento (0..1). Las cajas que ya toca al
+    // principio se ignoran, así un objeto que las atraviesa no choca con ellas en cada paso.
+    // Filtra con Test y el círculo que cubre el recorrido; al volver hits tiene un bit por cada caja
+    // que choca en ese mismo instante (varias si el círculo llega a la vez a dos cajas contiguas)
+    int Sweep(glm::vec2 center, float radius, glm::vec2 displacement, std::vector<std::uint32_t> &hits, float &time, glm::vec2 &normal);
+    // conjunto de instrucciones con el que se compiló Test
+    static const char *Kernel();
+
+private:
+
+    unsigned int count;
+    std::vector<float> times; // instante de impacto de cada caja durante Sweep
+};
+
+// Tiempo de impacto de un círculo que se desplaza contra una caja (rayo contra la caja ensanchada
+// por el radio, con esquinas redondeadas); mismas reglas que BoxBatch::Sweep
+bool SweepCircle(glm::vec2 center, float radius, glm::vec2 displacement, glm::vec2 min, glm::vec2 max, float &time, glm::vec2 &normal);
+
+#endif
@@ -0,0 +1,96 @@
+#include "distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const float INF = 1e20f;
+
+// Transformada de distancia euclídea exacta en 1D (Felzenszwalb y Huttenlocher):
+// d[q] = min_p (q - p)^2 + f[p], con la envolvente inferior de parábolas en O(n)
+static void transform1D(const float *f, float *d, int n, int *v, float *z)
+{
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+    for (int q = 1; q < n; ++q)
+    {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * (q - v[k]));
+        while (s <= z[k])
+        {
+            --k;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * (q - v[k]));
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INF;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q)
+    {
+        while (z[k + 1] < q)
+            ++k;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+// Distancia al cuadrado de cada píxel al píxel "semilla" más cercano (grid: 0 en semillas, INF fuera)
+static void transform2D(std::vector<float> &grid, int width, int height)
+{
+    int n = std::max(width, height);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+    for (int x = 0; x < width; ++x)
+    {
+        for (int y = 0; y < height; ++y)
+            f[y] = grid[y * width + x];
+        transform1D(f.data(), d.data(), height, v.data(), z.data());
+        for (int y = 0; y < height; ++y)
+            grid[y * width + x] = d[y];
+    }
+    for (int y = 0; y < height; ++y)
+    {
+        transform1D(&grid[y * width], d.data(), width, v.data(), z.data());
+        std::copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+    }
+}
+
+void BuildDistanceField(const unsigned char *coverage, int width, int height, int pitch,
+                        int upscale, int spread,
+                        std::vector<unsigned char> &field, int &fieldWidth, int &fieldHeight)
+{
+    // rejilla de alta resolución con el margen incluido y redondeada a múltiplos de upscale
+    int pad = spread * upscale;
+    fieldWidth = (width + upscale - 1) / upscale + 2 * spread;
+    fieldHeight = (height + upscale - 1) / upscale + 2 * spread;
+    int gridWidth = fieldWidth * upscale, gridHeight = fieldHeight * upscale;
+    std::vector<float> inside(gridWidth * gridHeight, INF), outside(gridWidth * gridHeight, 0.0f);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            if (coverage[y * pitch + x] >= 128)
+            {
+                int i = (y + pad) * gridWidth + x + pad;
+                inside[i] = 0.0f;
+                outside[i] = INF;
+            }
+    transform2D(inside, gridWidth, gridHeight);   // distancia al interior (para píxeles de fuera)
+    transform2D(outside, gridWidth, gridHeight);  // distancia al exterior (para píxeles de dentro)
+
+    // cada píxel final promedia la distancia con signo de su bloque upscale x upscale
+    field.resize(fieldWidth * fieldHeight);
+    float scale = 127.0f / (spread * upscale);
+    for (int fy = 0; fy < fieldHeight; ++fy)
+        for (int fx = 0; fx < fieldWidth; ++fx)
+        {
+            float sum = 0.0f;
+            for (int y = fy * upscale; y < (fy + 1) * upscale; ++y)
+                for (int x = fx * upscale; x < (fx + 1) * upscale; ++x)
+                {
+                    int i = y * gridWidth + x;
+                    sum += std::sqrt(outside[i]) - std::sqrt(inside[i]);
+                }
+            float distance = sum / (upscale * upscale);
+            field[fy * fieldWidth + fx] = static_cast<unsigned char>(std::min(255.0f, std::max(0.0f, 128.0f + distance * scale)));
+        }
+}
@@ -0,0 +1,12 @@
+#ifndef DISTANCE_FIELD_H
+#define DISTANCE_FIELD_H
+#include <vector>
+
+// Campo de distancia con signo a partir de la cobertura de un glifo rasterizado a upscale
+// veces el tamaño final. El resultado tiene spread píxeles de margen por cada lado y
+// codifica el borde en 128: > 128 dentro, < 128 fuera, saturando a spread píxeles.
+void BuildDistanceField(const unsigned char *coverage, int width, int height, int pitch,
+                        int upscale, int spread,
+                        std::vector<unsigned char> &field, int &fieldWidth, int &fieldHeight);
+
+#endif
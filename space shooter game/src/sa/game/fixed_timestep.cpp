@@ -0,0 +1,34 @@
+#include "fixed_timestep.h"
+
+FixedTimestep::FixedTimestep(float tickRate, unsigned int maxTicks)
+    : Step(1.0f / tickRate), MaxTicks(maxTicks), Dropped(0.0f), accumulator(0.0f) { }
+
+void FixedTimestep::SetTickRate(float tickRate)
+{
+    this->Step = 1.0f / tickRate;
+}
+
+unsigned int FixedTimestep::Advance(float frameTime)
+{
+    if (frameTime > 0.0f)
+        this->accumulator += frameTime;
+    // límite de recuperación: lo que no cabe en MaxTicks ticks no se simula
+    float limit = this->Step * this->MaxTicks;
+    if (this->accumulator > limit)
+    {
+        this->Dropped += this->accumulator - limit;
+        this->accumulator = limit;
+    }
+    unsigned int ticks = 0;
+    while (this->accumulator >= this->Step)
+    {
+        this->accumulator -= this->Step;
+        ++ticks;
+    }
+    return ticks;
+}
+
+float FixedTimestep::Alpha() const
+{
+    return this->accumulator / this->Step;
+}
@@ -0,0 +1,29 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+// Reparte el tiempo real de cada frame en ticks de simulación de duración fija. Lo que sobra se
+// guarda para el frame siguiente, y Alpha() dice cuánto del próximo tick ha pasado ya, para
+// interpolar el dibujo entre el estado anterior y el actual.
+// Si un frame se atrasa mucho, como máximo se simulan MaxTicks ticks y el resto del tiempo se
+// descarta: el juego va más lento un momento en lugar de hundirse intentando ponerse al día.
+class FixedTimestep
+{
+public:
+
+    float        Step;     // segundos por tick (1 / frecuencia)
+    unsigned int MaxTicks; // ticks por frame como máximo
+    float        Dropped;  // segundos descartados por el límite desde el inicio
+
+    FixedTimestep(float tickRate, unsigned int maxTicks);
+    void SetTickRate(float tickRate);
+    // suma el tiempo del frame y devuelve cuántos ticks hay que simular
+    unsigned int Advance(float frameTime);
+    // fracción (0..1) del tick siguiente ya transcurrida
+    float Alpha() const;
+
+private:
+
+    float accumulator;
+};
+
+#endif
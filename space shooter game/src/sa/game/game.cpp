@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <sstream>
 #include <learnopengl/filesystem.h>
 #include <irrklang/irrKlang.h>
 using namespace irrklang;
@@ -7,15 +6,18 @@ using namespace irrklang;
 #include "resource_manager.h"
 #include "sprite_renderer.h"
 #include "game_object.h"
-#include "ball_object.h"
-#include "particle_generator.h"
+#include "particle_system.h"
 #include "post_processor.h"
 #include "text_renderer.h"
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include "box_batch.h"
+#include "projectile_pool.h"
 // punteros globales para objetos
 SpriteRenderer* Renderer;
 GameObject* Player;
-BallObject* Ball;
-ParticleGenerator* Particles;
+ParticleSystem* Particles;
+int ShipTrail; // emisor de la estela de la nave
 GameObject* Fruit;
 GameObject* Hearts;
 GameObject* Hearts2;
@@ -25,6 +27,13 @@ GameObject* Fire;
 GameObject* Background;
 PostProcessor* Effects;
 TextRenderer* Text;
+std::vector<unsigned int> BrickCandidates; // resultado de la fase amplia, reutilizado cada frame
+BoxBatch CandidateBoxes;                   // cajas de los candidatos para la fase estrecha
+std::vector<std::uint32_t> BrickHits;      // un bit por candidato tocado
+ProjectilePool Projectiles(MAX_PROJECTILES); // balas del jugador
+float PlayerFireCooldown = 0.0f;
+// textos persistentes: solo se regeneran cuando cambian
+int ScoreLabel, MenuLabels[2], WinLabels[2], LoseLabels[2];
 #ifndef __APPLE__
 ISoundEngine* SoundEngine = createIrrKlangDevice();
 #endif
@@ -38,9 +47,15 @@ Game::Game(unsigned int width, unsigned int height)
 // limpiar memoria
 Game::~Game()
 {
+    Projectiles.Report();
+    if (Renderer)
+        Renderer->Report();
+    if (Particles)
+        Particles->Report();
+    if (this->Level < this->Levels.size())
+        this->Levels[this->Level].Report();
     delete Renderer;
     delete Player;
-    delete Ball;
     delete Particles;
     delete Fruit;
     delete Hearts;
@@ -56,52 +71,91 @@ Game::~Game()
 #endif
 }
 
-void Game::Init()
+void Game::Init(LoadProgressCallback progress)
 {
+ // si existe el paquete de assets todo se lee de él; si no, de los archivos sueltos
+    if (AssetPack::Mount("assets.pak"))
+    {
+#ifndef __APPLE__
+        const char *sounds[] = { "resources/audio/LosingControl.mp3", "resources/audio/solid.wav", "resources/audio/bleep.mp3", "resources/audio/bleep.wav" };
+        for (const char *sound : sounds)
+        {
+            AssetView view;
+            if (AssetPack::Load(sound, view))
+                SoundEngine->addSoundSourceFromMemory(const_cast<unsigned char*>(view.Data), static_cast<irrklang::ik_s32>(view.Size), sound, true);
+        }
+#endif
+    }
 #ifndef __APPLE__
-    SoundEngine->play2D("LosingControl.mp3", true);  // musica en bucle
+    SoundEngine->play2D("resources/audio/LosingControl.mp3", true);  // musica en bucle
 #endif
+ // los hilos de carga leen y decodifican; aquí solo se suben a GL y se enlazan programas, en este orden
+    AssetLoader loader;
  // carga shader
-    ResourceManager::LoadShader("sprite.vs", "sprite.fs", nullptr, "sprite");
-    ResourceManager::LoadShader("particle.vs", "particle.fs", nullptr, "particle");
-    ResourceManager::LoadShader("post_processing.vs", "post_processing.fs", nullptr, "postprocessing");
-
-    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->Width), static_cast<float>(this->Height), 0.0f, -1.0f, 1.0f);
-    ResourceManager::GetShader("sprite").Use().SetInteger("sprite", 0);
-    ResourceManager::GetShader("sprite").SetMatrix4("projection", projection);
-    ResourceManager::GetShader("particle").Use().SetInteger("sprite", 0);
-    ResourceManager::GetShader("particle").SetMatrix4("projection", projection);
+    loader.QueueShader("sprite.vs", "sprite.fs", nullptr, "sprite");
+    loader.QueueShader("sprite_batch.vs", "sprite_batch.fs", nullptr, "sprite_batch");
+    loader.QueueShader("particle.vs", "particle.fs", nullptr, "particle");
+    loader.QueueShader("post_processing.vs", "post_processing.fs", nullptr, "postprocessing");
+
+    loader.QueueMainThread([this]() {
+        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(this->Width), static_cast<float>(this->Height), 0.0f, -1.0f, 1.0f);
+        ResourceManager::GetShader("sprite").Use().SetInteger("sprite", 0);
+        ResourceManager::GetShader("sprite").SetMatrix4("projection", projection);
+        ResourceManager::GetShader("sprite_batch").Use().SetInteger("sprite", 0);
+        ResourceManager::GetShader("sprite_batch").SetMatrix4("projection", projection);
+        ResourceManager::GetShader("particle").Use().SetInteger("sprite", 0);
+        ResourceManager::GetShader("particle").SetMatrix4("projection", projection);
+    });
 
     // carga texturas
-    ResourceManager::LoadTexture("resources/textures/2.png", true, "background");
-    ResourceManager::LoadTexture("resources/textures/2.png", true, "background1");
-    ResourceManager::LoadTexture("resources/textures/spaceN.png", true, "shot");
-    ResourceManager::LoadTexture("resources/textures/2.png", true, "background2");
-    ResourceManager::LoadTexture("resources/textures/hearts.png", true, "hearts");
-    ResourceManager::LoadTexture("resources/textures/hearts2.png", true, "hearts2");
-    ResourceManager::LoadTexture("resources/textures/hearts3.png", true, "hearts3");
-    ResourceManager::LoadTexture("resources/textures/nave1.png", true, "nave");
-    ResourceManager::LoadTexture("resources/textures/empty.png", true, "empty");
-    ResourceManager::LoadTexture("resources/textures/paddle.png", true, "paddle");
-    ResourceManager::LoadTexture("resources/textures/hearts.png", true, "particle"); 
-    ResourceManager::LoadTexture("resources/textures/BalasEnemy.png", true, "balasEnemy"); 
+    loader.QueueTexture("resources/textures/2.png", true, "background");
+    loader.QueueTexture("resources/textures/2.png", true, "background1");
+    loader.QueueTexture("resources/textures/2.png", true, "background2");
+    loader.QueueTexture("resources/textures/winner.png", false, "winner");
+    // sprites pequeños: se empaquetan en páginas de atlas para dibujarlos con pocos cambios de textura
+    loader.QueueAtlasTexture("resources/textures/spaceN.png", "shot");
+    loader.QueueAtlasTexture("resources/textures/hearts.png", "hearts");
+    loader.QueueAtlasTexture("resources/textures/hearts2.png", "hearts2");
+    loader.QueueAtlasTexture("resources/textures/hearts3.png", "hearts3");
+    loader.QueueAtlasTexture("resources/textures/nave1.png", "nave");
+    loader.QueueAtlasTexture("resources/textures/empty.png", "empty");
+    loader.QueueAtlasTexture("resources/textures/paddle.png", "paddle");
+    loader.QueueAtlasTexture("resources/textures/hearts.png", "particle"); 
+    loader.QueueAtlasTexture("resources/textures/BalasEnemy.png", "balasEnemy"); 
+    loader.QueueMainThread([]() { ResourceManager::BuildAtlas(); });
 
   // Configuración de controles específicos de renderizado
-    Renderer = new SpriteRenderer(ResourceManager::GetShader("sprite"));
-    Particles = new ParticleGenerator(ResourceManager::GetShader("particle"), ResourceManager::GetTexture("particle"), 500);
-    Effects = new PostProcessor(ResourceManager::GetShader("postprocessing"), this->Width, this->Height);
-    Text = new TextRenderer(this->Width, this->Height);
-    Text->Load("resources/fonts/OCRAEXT.TTF", 24);
+    loader.QueueMainThread([this]() {
+        Renderer = new SpriteRenderer(ResourceManager::GetShader("sprite"), ResourceManager::GetShader("sprite_batch"));
+        Particles = new ParticleSystem(ResourceManager::GetShader("particle"), 500);
+        // simulación en GPU para los emisores que la piden; si no enlaza, todo sigue en CPU
+        Particles->EnableGPU(ResourceManager::LoadFeedbackShader("particle_update.vs", PARTICLE_FEEDBACK_VARYINGS, "particle_update"));
+        ParticleEmitter trail;
+        trail.Rate = 120.0f; // 2 por frame a 60 fps
+        trail.Lifetime = 0.4f;
+        trail.PositionSpread = 5.0f;
+        trail.Brightness = 0.5f;
+        trail.Texture = ResourceManager::GetTexture("particle");
+        trail.GPUParticles = 64; // ~48 vivas a la vez
+        ShipTrail = Particles->CreateEmitter(trail);
+        Effects = new PostProcessor(ResourceManager::GetShader("postprocessing"), this->Width, this->Height);
+        Text = new TextRenderer(this->Width, this->Height);
+        Text->Load("resources/fonts/OCRAEXT.TTF", 24, TEXT_SDF); // nítido también a escala 0.75
+        ScoreLabel = Text->CreateLabel("Points:", 5.0f, 5.0f, 1.0f, glm::vec3(1.0f), 16);
+        MenuLabels[0] = Text->CreateLabel("Presiona ENTER para comenzar", this->Width / 2.0f - 200.0f, this->Height / 5.0f, 1.0f);
+        MenuLabels[1] = Text->CreateLabel("Presiona Arriba o Abajo para seleccionar nivel", this->Width / 2.0f - 225.0f, this->Height / 2.0f + 20.0f, 0.75f);
+        WinLabels[0] = Text->CreateLabel("¡¡Has ganado!!", this->Width / 2.0f - 70.0f, this->Height / 2.0f - 20.0f, 1.0f, glm::vec3(0.0f, 1.0f, 0.0f));
+        WinLabels[1] = Text->CreateLabel("Presiona ENTER para volver a intenrarlo o ESC para salir", this->Width / 2.0f - 260.0f, this->Height / 2.0f, 1.0f, glm::vec3(1.0f, 1.0f, 0.0f));
+        LoseLabels[0] = Text->CreateLabel("¡¡Has perdido!!", this->Width / 2.0f - 70.0f, this->Height / 2.0f - 20.0f, 1.0f, glm::vec3(0.0f, 1.0f, 0.0f));
+        LoseLabels[1] = Text->CreateLabel("Presiona ENTER para volver a intenrarlo o ESC para salir", this->Width / 2.0f - 260.0f, this->Height / 2.0f, 1.0f, glm::vec3(1.0f, 1.0f, 0.0f));
+    });
     // Carga de niveles del juego
-    GameLevel one; one.Load("resources/levels/one.lvl", this->Width, this->Height / 2);
-    GameLevel two; two.Load("resources/levels/two.lvl", this->Width, this->Height / 2);
-    GameLevel three; three.Load("resources/levels/three.lvl", this->Width, this->Height / 2);
-    GameLevel four; four.Load("resources/levels/four.lvl", this->Width, this->Height / 2);
-
-    this->Levels.push_back(one);
-    this->Levels.push_back(two);
-    this->Levels.push_back(three);
-    this->Levels.push_back(four);
+    this->Levels.resize(4);
+    loader.QueueLevel("resources/levels/one.lvl", &this->Levels[0], this->Width, this->Height / 2);
+    loader.QueueLevel("resources/levels/two.lvl", &this->Levels[1], this->Width, this->Height / 2);
+    loader.QueueLevel("resources/levels/three.lvl", &this->Levels[2], this->Width, this->Height / 2);
+    loader.QueueLevel("resources/levels/four.lvl", &this->Levels[3], this->Width, this->Height / 2);
+    loader.Run(progress);
     this->Level = 0;
 // Posiciones de objetos
     glm::vec2 playerPos = glm::vec2(PLAYER_SIZE.x / 15.0f, this->Height / 2.0f - PLAYER_SIZE.y);
@@ -113,9 +167,6 @@ void Game::Init()
     glm::vec2 PausePos = glm::vec2(this->Width / 2.0f - 200, this->Height / 2.0f - 170);
     Pause = new GameObject(PausePos, PAUSE_SIZE, ResourceManager::GetTexture("pause"));
 
-    glm::vec2 ballPos = playerPos + glm::vec2(PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -BALL_RADIUS * 2.0f);
-    Ball = new BallObject(ballPos, BALL_RADIUS, INITIAL_BALL_VELOCITY, ResourceManager::GetTexture("shot"));
-
     glm::vec2 backgroundPos = glm::vec2(0.0f, 0.0f);
     Background = new GameObject(backgroundPos, glm::vec2(this->Width, this->Height), ResourceManager::GetTexture("background"));
 
@@ -130,9 +181,12 @@ void Game::Init()
 void Game::Update(float dt)
 {
     this->Points = this->Points;
-    Ball->Move(dt, this->Width); //mueve la bola
-    this->DoCollisions(); // manejando colisiones
-    Particles->Update(dt, *Ball, 2, glm::vec2(Ball->Radius / 2.0f)); // actualiza las particulas
+    this->UpdateProjectiles(dt); // disparos, colisiones y movimiento de las balas
+    this->DoCollisions(); // recoge los powerups
+    ParticleEmitter &trail = Particles->Emitter(ShipTrail); // la estela sale de la cola de la nave
+    trail.Position = Player->Position + glm::vec2(Player->Size.x / 2.0f, Player->Size.y);
+    trail.Velocity = glm::vec2(0.0f, SHIP_TRAIL_SPEED);
+    Particles->Update(dt); // actualiza las particulas
 
     this->UpdatePowerUps(dt);  // actualiza los powerups 
     // tiempo de sacudida
@@ -154,10 +208,10 @@ void Game::Update(float dt)
         this->ResetPlayer();
         Effects->Chaos = false;
         this->State = GAME_WIN;
-        ResourceManager::LoadTexture("resources/textures/1.png", false, "background");
+        ResourceManager::AliasTexture("background", "winner"); // fondo de victoria, ya cargado en Init
     }
     if(this->State == GAME_LOSE){
-         ResourceManager::LoadTexture("resources/textures/2.png", false, "background");
+        ResourceManager::AliasTexture("background", "background1");
         Effects->Chaos=true;
     }
 }
@@ -262,20 +316,35 @@ void Game::ProcessInput(float mt)
     }
 }
 
+void Game::BeginTick()
+{
+    Player->SaveTransform();
+    for (PowerUp& powerUp : this->PowerUps)
+        powerUp.SaveTransform();
+}
+
 //renderizado
-void Game::Render()
+void Game::Render(float alpha)
 {
     if (this->State == GAME_ACTIVE || this->State == GAME_MENU || this->State == GAME_WIN || this->State == GAME_ATTACK || this->State == GAME_HURT || this->State == GAME_LOSE)
     {
+        Renderer->ResetStats(); // contadores de lotes por frame
         Effects->BeginRender();
-        Renderer->DrawSprite(ResourceManager::GetTexture("background"), glm::vec2(0.0f, 0.0f), glm::vec2(this->Width, this->Height), 0.0f);
+        Renderer->DrawSprite(ResourceManager::GetTexture("background"_rid), glm::vec2(0.0f, 0.0f), glm::vec2(this->Width, this->Height), 0.0f);
         Effects->EndRender();
         Effects->Render(glfwGetTime()); //efectos de postprocesamiento
         this->Levels[this->Level].Draw(*Renderer); // nivel actual
-        Player->Draw(*Renderer); //dibujar jugador
+        Player->Draw(*Renderer, alpha); //dibujar jugador
+        Renderer->Begin();
         for (PowerUp& powerUp : this->PowerUps)
             if (!powerUp.Destroyed)
-                powerUp.Draw(*Renderer);
+                powerUp.Submit(*Renderer, alpha);
+        // todas las balas en el mismo lote
+        Texture2D shot = ResourceManager::GetTexture("shot"_rid);
+        for (unsigned int i = 0; i < Projectiles.End(); ++i)
+            if (Projectiles.Alive[i])
+                Renderer->Submit(shot, Projectiles.InterpolatedPosition(i, alpha) - SHOT_RADIUS, glm::vec2(SHOT_RADIUS * 2.0f));
+        Renderer->Flush();
         Particles->Draw();
         if (Lives ==3)
             Hearts3->Draw(*Renderer);
@@ -285,43 +354,31 @@ void Game::Render()
             Hearts->Draw(*Renderer);
         if (Lives <= 1)
         Effects->Chaos= true;
-        Ball->Draw(*Renderer);
 
-        std::stringstream ss; ss << this->Lives;
-         std::stringstream pp; pp << this->Points;
-        Text->RenderText("Points:" + pp.str(), 5.0f, 5.0f, 1.0f); //Score
+        Text->SetLabelNumber(ScoreLabel, this->Points); // sin coste si la puntuación no cambió
+        Text->RenderLabel(ScoreLabel); //Score
     }
     if (this->State == GAME_MENU)
     {
-        Text->RenderText("Presiona ENTER para comenzar", this->Width / 2.0f - 200.0f, this->Height / 5.0f, 1.0f);
-        Text->RenderText("Presiona Arriba o Abajo para seleccionar nivel", this->Width / 2.0f - 225.0f, this->Height / 2.0f + 20.0f, 0.75f);
-    }
-    if (this->State == GAME_ATTACK)
-    {
-        glm::vec2 playerPos = glm::vec2(Player->Position.x, Player->Position.y);
-        glm::vec2 ballPos = playerPos + glm::vec2(PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -BALL_RADIUS * 2.0f);
-        Ball = new BallObject(ballPos, BALL_RADIUS, INITIAL_BALL_VELOCITY, ResourceManager::GetTexture("shot"));
-        Ball->Draw(*Renderer);
-        this->State = GAME_ACTIVE;
+        Text->RenderLabel(MenuLabels[0]);
+        Text->RenderLabel(MenuLabels[1]);
     }
-
     if (this->State == GAME_WIN)
     {
-        Text->RenderText("¡¡Has ganado!!", this->Width / 2.0f - 70.0f, this->Height / 2.0f - 20.0f, 1.0f, glm::vec3(0.0f, 1.0f, 0.0f));
-        Text->RenderText("Presiona ENTER para volver a intenrarlo o ESC para salir", this->Width / 2.0f - 260.0f, this->Height / 2.0f, 1.0f, glm::vec3(1.0f, 1.0f, 0.0f));
-        ResourceManager::LoadTexture("resources/textures/winner.png", false, "background");
+        Text->RenderLabel(WinLabels[0]);
+        Text->RenderLabel(WinLabels[1]);
     }
     if (this->State == GAME_LOSE)
     {
-        Text->RenderText("¡¡Has perdido!!", this->Width / 2.0f - 70.0f, this->Height / 2.0f - 20.0f, 1.0f, glm::vec3(0.0f, 1.0f, 0.0f));
-        Text->RenderText("Presiona ENTER para volver a intenrarlo o ESC para salir", this->Width / 2.0f - 260.0f, this->Height / 2.0f, 1.0f, glm::vec3(1.0f, 1.0f, 0.0f));
-        ResourceManager::LoadTexture("resources/textures/winner.png", false, "background");
+        Text->RenderLabel(LoseLabels[0]);
+        Text->RenderLabel(LoseLabels[1]);
         Effects->Chaos= true;
     }
 }
 
 void Game::ResetLevel()
 {
+    this->Levels[this->Level].Report(); // antes de recargar, que pone los totales a cero
     if (this->Level == 0)
         this->Levels[0].Load("levels/one.lvl", this->Width, this->Height / 2);
     else if (this->Level == 1)
@@ -332,16 +389,19 @@ void Game::ResetLevel()
         this->Levels[3].Load("levels/four.lvl", this->Width, this->Height / 2);
     this->Lives = 3;
     this->Points = 0;
+    Projectiles.Report(); // ocupación de la partida que termina
+    Renderer->Report();
+    Particles->Report();
+    Projectiles.Clear();
 }
 
 void Game::ResetPlayer()
 {
     Player->Size = PLAYER_SIZE;
     Player->Position = glm::vec2(this->Width / 2.0f - PLAYER_SIZE.x / 2.0f, this->Height - PLAYER_SIZE.y);
-    Ball->Reset(Player->Position + glm::vec2(PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -(BALL_RADIUS * 2.0f)), INITIAL_BALL_VELOCITY);
+    Player->SaveTransform();
     Effects->Chaos = Effects->Confuse = false;
     Player->Color = glm::vec3(1.0f);
-    Ball->Color = glm::vec3(1.0f);
 }
 
 void Game::UpdatePowerUps(float dt) //puntaje
@@ -365,6 +425,48 @@ void Game::UpdatePowerUps(float dt) //puntaje
     ), this->PowerUps.end());
 }
 
+// Los disparos se crean al principio del tick y se prueban contra el recorrido que harán en él,
+// así no atraviesan aviones aunque dt sea grande; después se mueven todos juntos y se liberan
+// los que salen de la pantalla
+void Game::UpdateProjectiles(float dt)
+{
+    GameLevel &level = this->Levels[this->Level];
+    level.ResetStats();
+    Projectiles.ResetStats();
+    // el jugador dispara mientras mantiene ESPACIO; GAME_ATTACK dura un tick
+    PlayerFireCooldown -= dt;
+    if (this->State == GAME_ATTACK)
+    {
+        if (PlayerFireCooldown <= 0.0f)
+        {
+            Projectiles.Spawn(glm::vec2(Player->Position.x + Player->Size.x / 2.0f, Player->Position.y), glm::vec2(0.0f, -PLAYER_SHOT_SPEED));
+            PlayerFireCooldown = PLAYER_FIRE_INTERVAL;
+        }
+        this->State = GAME_ACTIVE;
+    }
+    // cada bala contra los ladrillos que cruza su recorrido; se libera en el primer impacto
+    for (unsigned int i = 0; i < Projectiles.End(); ++i)
+    {
+        if (!Projectiles.Alive[i])
+            continue;
+        glm::vec2 position = Projectiles.Position(i);
+        glm::vec2 displacement = glm::vec2(Projectiles.VelocityX[i], Projectiles.VelocityY[i]) * dt;
+        level.QueryCircle(position + displacement * 0.5f, SHOT_RADIUS + glm::length(displacement) * 0.5f, BrickCandidates);
+        CandidateBoxes.Clear();
+        for (unsigned int index : BrickCandidates)
+            CandidateBoxes.Add(level.Bricks[index].Position, level.Bricks[index].Size);
+        float time;
+        glm::vec2 normal;
+        if (CandidateBoxes.Sweep(position, SHOT_RADIUS, displacement, BrickHits, time, normal) < 0)
+            continue;
+        for (unsigned int c = 0; c < BrickCandidates.size(); ++c)
+            if (BrickHits[c / 32] & (1u << (c % 32)))
+                this->HitBrick(BrickCandidates[c]);
+        Projectiles.Despawn(i);
+    }
+    Projectiles.Update(dt, glm::vec2(-SHOT_RADIUS), glm::vec2(this->Width + SHOT_RADIUS, this->Height + SHOT_RADIUS));
+}
+
 bool ShouldSpawn(unsigned int chance)
 {
     unsigned int random = rand() % chance;
@@ -373,7 +475,7 @@ bool ShouldSpawn(unsigned int chance)
 void Game::SpawnPowerUps(GameObject& block)
 {
     if (ShouldSpawn(5)) // 1 en 55
-        this->PowerUps.push_back(PowerUp("speed", glm::vec3(1.5f, 1.5f, 0.0f), 0.0f, block.Position, ResourceManager::GetTexture("balasEnemy"))); // balas
+        this->PowerUps.push_back(PowerUp("speed", glm::vec3(1.5f, 1.5f, 0.0f), 0.0f, block.Position, ResourceManager::GetTexture("balasEnemy"_rid))); // balas
 
 }
 
@@ -397,38 +499,8 @@ bool IsOtherPowerUpActive(std::vector<PowerUp>& powerUps, std::string type)
 }
 
 bool CheckCollision(GameObject& one, GameObject& two);
-Collision CheckCollision(BallObject& one, GameObject& two);
-Direction VectorDirection(glm::vec2 closest);
 void Game::DoCollisions()
 {
-    for (GameObject& box : this->Levels[this->Level].Bricks)
-    {
-        if (!box.Destroyed)
-        {
-            Collision collision = CheckCollision(*Ball, box);
-            if (std::get<0>(collision))
-            {
-                if (!box.IsSolid)
-                {
-                    box.Destroyed = true;
-                    this->SpawnPowerUps(box);
-#ifndef __APPLE__
-                    SoundEngine->play2D("resources/audio/solid.wav", false);
-#endif
-                    this->Points += 100; // Incrementa los puntos por cada avión eliminado
-                }
-                else
-                {
-                    ShakeTime = 0.05f;
-                    Effects->Shake = true;
-#ifndef __APPLE__
-                    SoundEngine->play2D("resources/audio/bleep.mp3", false);
-#endif
-                }
-            }
-        }
-    }
-
     for (PowerUp& powerUp : this->PowerUps)
     {
         if (!powerUp.Destroyed)
@@ -449,25 +521,31 @@ void Game::DoCollisions()
             }
         }
     }
+}
 
-    Collision result = CheckCollision(*Ball, *Player);
-    if (std::get<0>(result))
+void Game::HitBrick(unsigned int index)
+{
+    GameLevel &level = this->Levels[this->Level];
+    GameObject& box = level.Bricks[index];
+    if (!box.IsSolid)
+    {
+        level.DestroyBrick(index);
+        this->SpawnPowerUps(box);
+#ifndef __APPLE__
+        SoundEngine->play2D("resources/audio/solid.wav", false);
+#endif
+        this->Points += 100; // Incrementa los puntos por cada avión eliminado
+    }
+    else
     {
-        float centerBoard = Player->Position.x + Player->Size.x / 2.0f;
-        float distance = (Ball->Position.x + Ball->Radius) - centerBoard;
-        float percentage = distance / (Player->Size.x / 2.0f);
-        float strength = 2.0f;
-        glm::vec2 oldVelocity = Ball->Velocity;
-        Ball->Velocity.x = INITIAL_BALL_VELOCITY.x * percentage * strength;
-        Ball->Velocity = glm::normalize(Ball->Velocity) * glm::length(oldVelocity);
-        Ball->Velocity.y = -1.0f * abs(Ball->Velocity.y);
+        ShakeTime = 0.05f;
+        Effects->Shake = true;
 #ifndef __APPLE__
-        SoundEngine->play2D("resources/audio/bleep.wav", false);
+        SoundEngine->play2D("resources/audio/bleep.mp3", false);
 #endif
     }
 }
 
-
 bool CheckCollision(GameObject& one, GameObject& two) // colisiones AABB -AABB
 {
     bool collisionX = one.Position.x + one.Size.x >= two.Position.x &&
@@ -476,42 +554,3 @@ bool CheckCollision(GameObject& one, GameObject& two) // colisiones AABB -AABB
                       two.Position.y + two.Size.y >= one.Position.y;
     return collisionX && collisionY;
 }
-
-Collision CheckCollision(BallObject& one, GameObject& two) // AABB 
-{
-    glm::vec2 center(one.Position + one.Radius);
-    glm::vec2 aabb_half_extents(two.Size.x / 2.0f, two.Size.y / 2.0f);
-    glm::vec2 aabb_center(two.Position.x + aabb_half_extents.x, two.Position.y + aabb_half_extents.y);
-    glm::vec2 difference = center - aabb_center;
-    glm::vec2 clamped = glm::clamp(difference, -aabb_half_extents, aabb_half_extents);
-    glm::vec2 closest = aabb_center + clamped;
-    difference = closest - center;
-    if (glm::length(difference) < one.Radius)
-        return std::make_tuple(true, VectorDirection(difference), difference);
-    else
-        return std::make_tuple(false, UP, glm::vec2(0.0f, 0.0f));
-}
-
-
-Direction VectorDirection(glm::vec2 target)
-{
-    glm::vec2 compass[] = {
-            glm::vec2(0.0f, 1.0f),	// up
-            glm::vec2(1.0f, 0.0f),	// right
-            glm::vec2(0.0f, -1.0f),	// down
-            glm::vec2(-1.0f, 0.0f)	// left
-    };
-    float max = 0.0f;
-    unsigned int best_match = -1;
-
-    for (unsigned int i = 0; i < 4; i++)
-    {
-        float dot_product = glm::dot(glm::normalize(target), compass[i]);
-        if (dot_product > max)
-        {
-            max = dot_product;
-            best_match = i;
-        }
-    }
-    return (Direction)best_match;
-}
\ No newline at end of file
@@ -1,11 +1,11 @@
 #ifndef GAME_H
 #define GAME_H
 #include <vector>
-#include <tuple>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "asset_loader.h"
 #include "game_level.h"
 #include "power_up.h"
 
@@ -19,15 +19,6 @@ enum GameState {
 };
 
 
-enum Direction {
-    UP,
-    RIGHT,
-    DOWN,
-    LEFT
-};
-
-typedef std::tuple<bool, Direction, glm::vec2> Collision; 
-
 const glm::vec2 PLAYER_SIZE(200.0f, 140.0f);
 const glm::vec2 ENEMY_SIZE(200.0f, 140.0f);
 const glm::vec2 FRUIT_SIZE(8.0f, 8.0f);
@@ -35,8 +26,13 @@ const glm::vec2 PAUSE_SIZE(300.0f, 300.0f);
 const glm::vec2 HEART_SIZE(180.0f, 70.0f);
 
 const float PLAYER_VELOCITY(500.0f);
-const glm::vec2 INITIAL_BALL_VELOCITY(100.0f, 950.0f);
-const float BALL_RADIUS = 10.0f;
+// velocidad hacia abajo de las partículas de la estela de la nave
+const float SHIP_TRAIL_SPEED = 95.0f;
+// Proyectiles: plazas del pool, radio y velocidad de las balas y segundos entre disparos
+const unsigned int MAX_PROJECTILES = 4096;
+const float SHOT_RADIUS = 6.0f;
+const float PLAYER_SHOT_SPEED = 950.0f;
+const float PLAYER_FIRE_INTERVAL = 0.12f;
 
 class Game
 {
@@ -52,15 +48,20 @@ public:
     unsigned int            Points;
     Game(unsigned int width, unsigned int height);
     ~Game();
-    void Init();
+    void Init(LoadProgressCallback progress = nullptr);
     void ProcessInput(float dt);
     void Update(float dt);
-    void Render();
+    // guarda las transformaciones de los objetos que se mueven; antes de cada tick
+    void BeginTick();
+    // alpha: fracción del tick siguiente ya transcurrida, para interpolar lo que se mueve
+    void Render(float alpha = 1.0f);
     void DoCollisions();
+    void HitBrick(unsigned int index);
     void ResetLevel();
     void ResetPlayer();
     void SpawnPowerUps(GameObject& block);
     void UpdatePowerUps(float dt);
+    void UpdateProjectiles(float dt);
 };
 
 #endif
\ No newline at end of file
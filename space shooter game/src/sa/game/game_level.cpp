@@ -1,21 +1,39 @@
 #include "game_level.h"
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
 #include <sstream>
+#include "asset_pack.h"
 
 // Función para cargar un nivel desde un archivo
 void GameLevel::Load(const char *file, unsigned int levelWidth, unsigned int levelHeight)
 {
     // Limpia los datos antiguos
     this->Bricks.clear();
+    this->grid.clear();
+    this->brickCells.clear();
+    this->ticks = this->peakCandidates = 0;
+    this->totalQueries = this->totalCandidates = 0;
+    this->Stats = CollisionStats();
     
     // Carga los datos del archivo
+    std::vector<std::vector<unsigned int>> tileData;
+    if (ParseTiles(file, tileData))
+        this->init(tileData, levelWidth, levelHeight);
+}
+
+// Lee los códigos de tiles de un archivo; no toca GL ni el ResourceManager
+bool GameLevel::ParseTiles(const char *file, std::vector<std::vector<unsigned int>> &tileData)
+{
     unsigned int tileCode;
-    GameLevel level;
     std::string line;
-    std::ifstream fstream(file);
-    std::vector<std::vector<unsigned int>> tileData;
+    // El nivel sale del paquete montado o del disco
+    AssetView view;
+    bool found = AssetPack::Load(file, view);
+    std::istringstream fstream(std::string(reinterpret_cast<const char*>(view.Data), view.Size));
+    tileData.clear();
 
-    if (fstream)
+    if (found)
     {
         // Lee cada línea del archivo
         while (std::getline(fstream, line)) 
@@ -30,20 +48,33 @@ void GameLevel::Load(const char *file, unsigned int levelWidth, unsigned int lev
             // Añade la fila al conjunto de datos de tiles
             tileData.push_back(row);
         }
-
-        // Si se han leído datos, inicializa el nivel
-        if (tileData.size() > 0)
-            this->init(tileData, levelWidth, levelHeight);
     }
+    // Hay nivel si se han leído datos
+    return tileData.size() > 0;
+}
+
+// Crea los ladrillos a partir de tiles ya leídos con ParseTiles
+void GameLevel::Build(const std::vector<std::vector<unsigned int>> &tileData, unsigned int levelWidth, unsigned int levelHeight)
+{
+    this->Bricks.clear();
+    this->grid.clear();
+    this->brickCells.clear();
+    this->ticks = this->peakCandidates = 0;
+    this->totalQueries = this->totalCandidates = 0;
+    this->Stats = CollisionStats();
+    if (tileData.size() > 0)
+        this->init(tileData, levelWidth, levelHeight);
 }
 
 // Función para dibujar el nivel
 void GameLevel::Draw(SpriteRenderer &renderer)
 {
-    // Dibuja cada ladrillo que no esté destruido
+    // Envía cada ladrillo que no esté destruido a un solo lote (una llamada por textura)
+    renderer.Begin();
     for (GameObject &tile : this->Bricks)
         if (!tile.Destroyed)
-            tile.Draw(renderer);
+            tile.Submit(renderer);
+    renderer.Flush();
 }
 
 // Verifica si el nivel está completado
@@ -56,8 +87,58 @@ bool GameLevel::IsCompleted()
     return true;
 }
 
+// Recorre solo las celdas que toca la caja del círculo
+void GameLevel::QueryCircle(glm::vec2 center, float radius, std::vector<unsigned int> &candidates)
+{
+    candidates.clear();
+    ++this->Stats.Queries;
+    if (this->grid.empty())
+        return;
+    // celdas del rango [centro - radio, centro + radio], recortadas a la rejilla; 1px de margen
+    // para que un círculo justo en el borde entre celdas no dependa del redondeo
+    radius += 1.0f;
+    int maxX = static_cast<int>(this->gridWidth) - 1, maxY = static_cast<int>(this->gridHeight) - 1;
+    int x0 = std::max(0, static_cast<int>(std::floor((center.x - radius) / this->unitSize.x)));
+    int y0 = std::max(0, static_cast<int>(std::floor((center.y - radius) / this->unitSize.y)));
+    int x1 = std::min(maxX, static_cast<int>(std::floor((center.x + radius) / this->unitSize.x)));
+    int y1 = std::min(maxY, static_cast<int>(std::floor((center.y + radius) / this->unitSize.y)));
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+        {
+            int brick = this->grid[y * this->gridWidth + x];
+            if (brick >= 0)
+                candidates.push_back(static_cast<unsigned int>(brick));
+        }
+    this->Stats.Candidates += static_cast<unsigned int>(candidates.size());
+}
+
+void GameLevel::DestroyBrick(unsigned int index)
+{
+    this->Bricks[index].Destroyed = true;
+    this->grid[this->brickCells[index]] = -1;
+}
+
+void GameLevel::ResetStats()
+{
+    this->totalQueries += this->Stats.Queries;
+    this->totalCandidates += this->Stats.Candidates;
+    this->peakCandidates = std::max(this->peakCandidates, this->Stats.Candidates);
+    ++this->ticks;
+    this->Stats = CollisionStats();
+}
+
+void GameLevel::Report() const
+{
+    // el tick en curso aún no se ha sumado
+    unsigned long long queries = this->totalQueries + this->Stats.Queries;
+    unsigned long long candidates = this->totalCandidates + this->Stats.Candidates;
+    std::cout << "COLLISIONS: " << queries << " grid queries in " << this->ticks << " ticks, " << candidates << " candidate bricks ("
+              << (queries > 0 ? static_cast<double>(candidates) / queries : 0.0) << " per query), peak " << std::max(this->peakCandidates, this->Stats.Candidates)
+              << " in one tick" << std::endl;
+}
+
 // Inicializa el nivel a partir de los datos de tiles
-void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned int levelWidth, unsigned int levelHeight)
+void GameLevel::init(const std::vector<std::vector<unsigned int>> &tileData, unsigned int levelWidth, unsigned int levelHeight)
 {
     unsigned int height = tileData.size(); // Altura del nivel en tiles
     unsigned int width = tileData[0].size(); // Ancho del nivel en tiles
@@ -66,16 +147,23 @@ void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned i
     float unit_width = levelWidth / static_cast<float>(width), 
           unit_height = levelHeight / height; 	
 
+    // rejilla de colisión con las mismas dimensiones que el nivel
+    this->gridWidth = width;
+    this->gridHeight = height;
+    this->unitSize = glm::vec2(unit_width, unit_height);
+    this->grid.assign(width * height, -1);
+
     // Recorre cada tile y crea el objeto correspondiente
     for (unsigned int y = 0; y < height; ++y)
     {
         for (unsigned int x = 0; x < width; ++x)
         {
+            std::size_t previous = this->Bricks.size();
             if (tileData[y][x] == 1) // Tile sólido
             {
                 glm::vec2 pos(unit_width * x, unit_height * y); // Posición del tile
                 glm::vec2 size(unit_width, unit_height); // Tamaño del tile
-                GameObject obj(pos, size, ResourceManager::GetTexture("empty"), glm::vec3(1.0f, 1.0f, 1.0f)); // Crea el objeto
+                GameObject obj(pos, size, ResourceManager::GetTexture("empty"_rid), glm::vec3(1.0f, 1.0f, 1.0f)); // Crea el objeto
                 obj.IsSolid = true; // Marca como sólido
                 this->Bricks.push_back(obj); // Añade el objeto a la lista de ladrillos
             }
@@ -84,14 +172,14 @@ void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned i
                 glm::vec3 color = glm::vec3(0.0f, 1.3f, 0.0f); // Color verde
                 glm::vec2 pos(unit_width * x, unit_height * y); // Posición del tile
                 glm::vec2 size(unit_width, unit_height); // Tamaño del tile
-                this->Bricks.push_back(GameObject(pos, size, ResourceManager::GetTexture("nave"), color)); // Crea y añade el objeto
+                this->Bricks.push_back(GameObject(pos, size, ResourceManager::GetTexture("nave"_rid), color)); // Crea y añade el objeto
             }
             else if (tileData[y][x] == 3) // Tile no sólido (tipo 3)
             {
                 glm::vec3 color = glm::vec3(1.0f, 0.0f, 1.0f); // Color púrpura
                 glm::vec2 pos(unit_width * x, unit_height * y); // Posición del tile
                 glm::vec2 size(unit_width, unit_height); // Tamaño del tile
-                this->Bricks.push_back(GameObject(pos, size, ResourceManager::GetTexture("nave"), color)); // Crea y añade el objeto
+                this->Bricks.push_back(GameObject(pos, size, ResourceManager::GetTexture("nave"_rid), color)); // Crea y añade el objeto
             }
             else if (tileData[y][x] > 3) // Otros tiles no sólidos
             {
@@ -105,8 +193,13 @@ void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned i
 
                 glm::vec2 pos(unit_width * x, unit_height * y); // Posición del tile
                 glm::vec2 size(unit_width, unit_height); // Tamaño del tile
-                this->Bricks.push_back(GameObject(pos, size, ResourceManager::GetTexture("nave"), color)); // Crea y añade el objeto
+                this->Bricks.push_back(GameObject(pos, size, ResourceManager::GetTexture("nave"_rid), color)); // Crea y añade el objeto
+            }
+            if (this->Bricks.size() > previous) // el tile ha creado un ladrillo
+            {
+                this->grid[y * width + x] = static_cast<int>(previous);
+                this->brickCells.push_back(y * width + x);
             }
         }
     }
-}
+}
\ No newline at end of file
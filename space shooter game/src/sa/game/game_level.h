@@ -7,20 +7,48 @@
 #include "sprite_renderer.h"
 #include "resource_manager.h"
 
+// Contadores de la fase amplia; se reinician con ResetStats() al inicio de cada tick, que los
+// acumula en los totales de la partida que muestra Report()
+struct CollisionStats {
+    unsigned int Queries = 0;    // consultas a la rejilla
+    unsigned int Candidates = 0; // ladrillos devueltos para la prueba exacta
+};
+
+// Los ladrillos se indexan en una rejilla uniforme con una celda por tile (el nivel ya es una
+// rejilla regular), de modo que una consulta solo visita las celdas que toca el objeto.
 class GameLevel
 {
 public:
 
     std::vector<GameObject> Bricks;
-    GameLevel() { }
+    CollisionStats Stats;
+    GameLevel() : gridWidth(0), gridHeight(0), unitSize(0.0f), ticks(0), totalQueries(0), totalCandidates(0), peakCandidates(0) { }
     void Load(const char *file, unsigned int levelWidth, unsigned int levelHeight);
+    // Load en dos pasos: ParseTiles solo lee el archivo (seguro en un hilo de carga) y Build crea los ladrillos
+    static bool ParseTiles(const char *file, std::vector<std::vector<unsigned int>> &tileData);
+    void Build(const std::vector<std::vector<unsigned int>> &tileData, unsigned int levelWidth, unsigned int levelHeight);
     void Draw(SpriteRenderer &renderer);
     glm::vec2 Move(float dt, unsigned int window_width);
     bool IsCompleted();
+    // índices de los ladrillos no destruidos en las celdas que cubre el círculo; reutiliza candidates
+    void QueryCircle(glm::vec2 center, float radius, std::vector<unsigned int> &candidates);
+    // marca el ladrillo como destruido y lo saca de su celda en O(1)
+    void DestroyBrick(unsigned int index);
+    void ResetStats();
+    // consultas y candidatos desde que se cargó el nivel
+    void Report() const;
 
 private:
 
-    void init(std::vector<std::vector<unsigned int>> tileData, unsigned int levelWidth, unsigned int levelHeight);
+    std::vector<int> grid;                // celda (y * gridWidth + x) -> índice en Bricks, -1 si vacía
+    std::vector<unsigned int> brickCells; // índice en Bricks -> celda
+    unsigned int gridWidth, gridHeight;
+    glm::vec2 unitSize;                   // tamaño de un tile en píxeles
+    unsigned int ticks;
+    unsigned long long totalQueries, totalCandidates;
+    unsigned int peakCandidates;          // máximo de candidatos en un tick
+
+    void init(const std::vector<std::vector<unsigned int>> &tileData, unsigned int levelWidth, unsigned int levelHeight);
 };
 
 #endif
\ No newline at end of file
@@ -2,14 +2,29 @@
 
 
 GameObject::GameObject() 
-    : Position(0.0f, 0.0f), Size(1.0f, 1.0f), Velocity(0.0f), Color(1.0f), Rotation(0.0f), Sprite(), IsSolid(false), Destroyed(false) { }
+    : Position(0.0f, 0.0f), Size(1.0f, 1.0f), Velocity(0.0f), PreviousPosition(0.0f, 0.0f), Color(1.0f), Rotation(0.0f), PreviousRotation(0.0f), IsSolid(false), Destroyed(false), Sprite() { }
 
 GameObject::GameObject(glm::vec2 pos, glm::vec2 size, Texture2D sprite, glm::vec3 color, glm::vec2 velocity) 
-    : Position(pos), Size(size), Velocity(velocity), Color(color), Rotation(0.0f), Sprite(sprite), IsSolid(false), Destroyed(false) { }
+    : Position(pos), Size(size), Velocity(velocity), PreviousPosition(pos), Color(color), Rotation(0.0f), PreviousRotation(0.0f), IsSolid(false), Destroyed(false), Sprite(sprite) { }
 
-void GameObject::Draw(SpriteRenderer &renderer)
+void GameObject::SaveTransform()
 {
-    renderer.DrawSprite(this->Sprite, this->Position, this->Size, this->Rotation, this->Color);
+    this->PreviousPosition = this->Position;
+    this->PreviousRotation = this->Rotation;
+}
+
+glm::vec2 GameObject::InterpolatedPosition(float alpha) const
+{
+    return glm::mix(this->PreviousPosition, this->Position, alpha);
+}
+
+void GameObject::Draw(SpriteRenderer &renderer, float alpha)
+{
+    renderer.DrawSprite(this->Sprite, this->InterpolatedPosition(alpha), this->Size, glm::mix(this->PreviousRotation, this->Rotation, alpha), this->Color);
+}
+void GameObject::Submit(SpriteRenderer &renderer, float alpha)
+{
+    renderer.Submit(this->Sprite, this->InterpolatedPosition(alpha), this->Size, glm::mix(this->PreviousRotation, this->Rotation, alpha), this->Color);
 }
 void GameObject::Instance(SpriteRenderer& renderer)
 {
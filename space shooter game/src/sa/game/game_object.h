@@ -6,18 +6,26 @@
 #include "sprite_renderer.h"
 
 
+// Position y Rotation son el estado del último tick de simulación; PreviousPosition y
+// PreviousRotation, el del tick anterior. Se dibuja interpolando entre ambos con alpha (0..1).
 class GameObject
 {
 public:
     glm::vec2   Position, Size, Velocity;
+    glm::vec2   PreviousPosition;
     glm::vec3   Color;
-    float       Rotation;
+    float       Rotation, PreviousRotation;
     bool        IsSolid;
     bool        Destroyed;
     Texture2D   Sprite;	
     GameObject();
     GameObject(glm::vec2 pos, glm::vec2 size, Texture2D sprite, glm::vec3 color = glm::vec3(1.0f), glm::vec2 velocity = glm::vec2(0.0f, 0.0f));
-    virtual void Draw(SpriteRenderer &renderer);
+    // guarda la transformación actual como la anterior: al inicio de cada tick, y tras
+    // recolocar el objeto (reinicios) para que no se interpole el salto
+    void SaveTransform();
+    glm::vec2 InterpolatedPosition(float alpha) const;
+    virtual void Draw(SpriteRenderer &renderer, float alpha = 1.0f);
+    virtual void Submit(SpriteRenderer &renderer, float alpha = 1.0f);
     virtual void Instance(SpriteRenderer& renderer);
 };
 
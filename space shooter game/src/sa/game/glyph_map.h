@@ -0,0 +1,95 @@
+#ifndef GLYPH_MAP_H
+#define GLYPH_MAP_H
+#include <vector>
+
+// Tabla hash plana de codepoint a índice (direccionamiento abierto con sondeo lineal).
+// Sin nodos: una búsqueda recorre posiciones contiguas del vector, y el borrado desplaza
+// hacia atrás las entradas siguientes en lugar de dejar lápidas.
+class GlyphMap
+{
+public:
+
+    GlyphMap() { this->Clear(16); }
+    // vacía la tabla; capacity se redondea a potencia de 2
+    void Clear(unsigned int capacity)
+    {
+        unsigned int size = 16;
+        while (size < capacity)
+            size <<= 1;
+        this->entries.assign(size, Entry());
+        this->mask = size - 1;
+        this->count = 0;
+    }
+    // -1 si no está
+    int Find(unsigned int key) const
+    {
+        for (unsigned int i = this->hash(key); ; i = (i + 1) & this->mask)
+        {
+            const Entry &entry = this->entries[i];
+            if (entry.Value < 0)
+                return -1;
+            if (entry.Key == key)
+                return entry.Value;
+        }
+    }
+    void Insert(unsigned int key, int value)
+    {
+        if ((this->count + 1) * 2 > this->entries.size()) // carga máxima del 50%
+            this->grow();
+        unsigned int i = this->hash(key);
+        while (this->entries[i].Value >= 0 && this->entries[i].Key != key)
+            i = (i + 1) & this->mask;
+        if (this->entries[i].Value < 0)
+            ++this->count;
+        this->entries[i].Key = key;
+        this->entries[i].Value = value;
+    }
+    void Erase(unsigned int key)
+    {
+        unsigned int i = this->hash(key);
+        while (this->entries[i].Key != key || this->entries[i].Value < 0)
+        {
+            if (this->entries[i].Value < 0)
+                return;
+            i = (i + 1) & this->mask;
+        }
+        this->entries[i].Value = -1;
+        --this->count;
+        // recoloca las entradas de la misma racha que ya no serían alcanzables desde su posición ideal
+        for (unsigned int j = (i + 1) & this->mask; this->entries[j].Value >= 0; j = (j + 1) & this->mask)
+        {
+            unsigned int ideal = this->hash(this->entries[j].Key);
+            bool between = i <= j ? (i < ideal && ideal <= j) : (i < ideal || ideal <= j);
+            if (between)
+                continue;
+            this->entries[i] = this->entries[j];
+            this->entries[j].Value = -1;
+            i = j;
+        }
+    }
+
+private:
+
+    struct Entry {
+        unsigned int Key = 0;
+        int          Value = -1; // < 0: posición libre
+    };
+    std::vector<Entry> entries;
+    unsigned int mask, count;
+    unsigned int hash(unsigned int key) const
+    {
+        key *= 0x9E3779B1u; // Fibonacci: reparte codepoints consecutivos
+        return (key ^ (key >> 16)) & this->mask;
+    }
+    void grow()
+    {
+        std::vector<Entry> old;
+        old.swap(this->entries);
+        this->Clear(static_cast<unsigned int>(old.size()) * 2);
+        for (const Entry &entry : old)
+            if (entry.Value >= 0)
+                this->Insert(entry.Key, entry.Value);
+    }
+};
+
+#endif
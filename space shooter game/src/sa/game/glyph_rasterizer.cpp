@@ -0,0 +1,88 @@
+#include "glyph_rasterizer.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "distance_field.h"
+
+GlyphRasterizer::GlyphRasterizer()
+    : CellWidth(0), CellHeight(0), ft(nullptr), face(nullptr), mode(TEXT_BITMAP)
+{
+}
+
+GlyphRasterizer::~GlyphRasterizer()
+{
+    this->Close();
+}
+
+bool GlyphRasterizer::Open(const unsigned char *data, std::size_t size, unsigned int fontSize, TextMode mode)
+{
+    this->Close();
+    this->mode = mode;
+    if (FT_Init_FreeType(&this->ft)) 
+    {
+        std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        this->ft = nullptr;
+        return false;
+    }
+    if (FT_New_Memory_Face(this->ft, data, static_cast<FT_Long>(size), 0, &this->face))
+    {
+        std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        this->face = nullptr;
+        return false;
+    }
+    // en modo SDF FreeType rasteriza a más resolución y las métricas se dividen por SDF_UPSCALE
+    unsigned int upscale = mode == TEXT_SDF ? SDF_UPSCALE : 1;
+    unsigned int padding = mode == TEXT_SDF ? 2 * SDF_SPREAD : 0;
+    FT_Set_Pixel_Sizes(this->face, 0, fontSize * upscale);
+
+    // caja que envuelve cualquier glifo de la fuente (+ margen del campo) + 1px para el filtrado lineal
+    const FT_Size_Metrics &metrics = this->face->size->metrics;
+    long width = metrics.max_advance, height = metrics.height;
+    if (FT_IS_SCALABLE(this->face))
+    {
+        width = FT_MulFix(this->face->bbox.xMax - this->face->bbox.xMin, metrics.x_scale);
+        height = FT_MulFix(this->face->bbox.yMax - this->face->bbox.yMin, metrics.y_scale);
+    }
+    this->CellWidth = (static_cast<unsigned int>((width + 63) >> 6) + upscale - 1) / upscale + padding + 1;
+    this->CellHeight = (static_cast<unsigned int>((height + 63) >> 6) + upscale - 1) / upscale + padding + 1;
+    return true;
+}
+
+void GlyphRasterizer::Close()
+{
+    if (this->face)
+        FT_Done_Face(this->face);
+    if (this->ft)
+        FT_Done_FreeType(this->ft);
+    this->face = nullptr;
+    this->ft = nullptr;
+}
+
+bool GlyphRasterizer::Rasterize(unsigned int codepoint, GlyphBitmap &glyph)
+{
+    glyph = GlyphBitmap();
+    if (!this->face || FT_Load_Char(this->face, codepoint, FT_LOAD_RENDER))
+        return false;
+    const FT_GlyphSlot slot = this->face->glyph;
+    glyph.Pixels = slot->bitmap.buffer;
+    glyph.Width = static_cast<int>(slot->bitmap.width);
+    glyph.Height = static_cast<int>(slot->bitmap.rows);
+    glyph.Pitch = slot->bitmap.pitch;
+    glyph.Bearing = glm::ivec2(slot->bitmap_left, slot->bitmap_top);
+    glyph.Advance = static_cast<unsigned int>(slot->advance.x);
+    if (this->mode == TEXT_SDF)
+    {
+        // el campo tiene SDF_SPREAD px de margen: el quad crece lo mismo por cada lado
+        if (glyph.Width > 0 && glyph.Height > 0)
+        {
+            BuildDistanceField(glyph.Pixels, glyph.Width, glyph.Height, glyph.Pitch, SDF_UPSCALE, SDF_SPREAD, this->field, glyph.Width, glyph.Height);
+            glyph.Pixels = this->field.data();
+            glyph.Pitch = glyph.Width;
+        }
+        glyph.Bearing = glm::ivec2(static_cast<int>(std::floor(glyph.Bearing.x / static_cast<float>(SDF_UPSCALE))) - static_cast<int>(SDF_SPREAD),
+                                   static_cast<int>(std::ceil(glyph.Bearing.y / static_cast<float>(SDF_UPSCALE))) + static_cast<int>(SDF_SPREAD));
+        glyph.Advance /= SDF_UPSCALE;
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef GLYPH_RASTERIZER_H
+#define GLYPH_RASTERIZER_H
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+// Lado por defecto de la página de glifos (GL_RED); es el presupuesto del caché de glifos
+const unsigned int GLYPH_ATLAS_SIZE = 512;
+// Campos de distancia: se rasteriza a SDF_UPSCALE veces el tamaño y se deja SDF_SPREAD px de margen
+const unsigned int SDF_UPSCALE = 4;
+const unsigned int SDF_SPREAD = 4;
+
+// Qué guarda el atlas de cada glifo
+enum TextMode {
+    TEXT_BITMAP, // cobertura al tamaño de carga; se emborrona al escalar
+    TEXT_SDF     // campo de distancia con signo (text_sdf.fs); nítido a cualquier escala
+};
+
+// Glifo rasterizado: Pixels es válido hasta la siguiente llamada a Rasterize
+struct GlyphBitmap {
+    const unsigned char *Pixels = nullptr;
+    int          Width = 0, Height = 0, Pitch = 0;
+    glm::ivec2   Bearing = glm::ivec2(0);
+    unsigned int Advance = 0; // 26.6
+};
+
+// Rasteriza glifos con FreeType, como cobertura o como campo de distancia, sin tocar GL.
+// Lo comparten TextRenderer (glifos que no están horneados) y la herramienta font_baker.
+class GlyphRasterizer
+{
+public:
+
+    // celda del atlas que envuelve cualquier glifo de la fuente, con 1px de margen
+    unsigned int CellWidth, CellHeight;
+    GlyphRasterizer();
+    ~GlyphRasterizer();
+    GlyphRasterizer(const GlyphRasterizer &) = delete;
+    GlyphRasterizer &operator=(const GlyphRasterizer &) = delete;
+    // data debe seguir vivo mientras esté abierta
+    bool Open(const unsigned char *data, std::size_t size, unsigned int fontSize, TextMode mode);
+    void Close();
+    bool IsOpen() const { return this->face != nullptr; }
+    bool Rasterize(unsigned int codepoint, GlyphBitmap &glyph);
+
+private:
+    FT_Library ft;
+    FT_Face    face;
+    TextMode   mode;
+    std::vector<unsigned char> field; // campo de distancia del último glifo
+};
+
+#endif
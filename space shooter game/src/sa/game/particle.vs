@@ -1,17 +1,40 @@
 #version 330 core
 layout (location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
+// per-instance attributes, one stream per ParticleBuffer array
+layout (location = 1) in float positionX;
+layout (location = 2) in float positionY;
+layout (location = 3) in float tintR;
+layout (location = 4) in float tintG;
+layout (location = 5) in float tintB;
+layout (location = 6) in float tintA;
+layout (location = 7) in float life;    // seconds left
+layout (location = 8) in float emitter; // index into the emitter tables
 
 out vec2 TexCoords;
 out vec4 ParticleColor;
 
 uniform mat4 projection;
-uniform vec2 offset;
-uniform vec4 color;
+// emitter tables (MAX_PARTICLE_EMITTERS entries)
+uniform vec4 emitterUV[32];     // sub-rectangle of the texture (u0, v0, u1, v1)
+uniform vec4 emitterStart[32];  // color at birth
+uniform vec4 emitterEnd[32];    // color at death
+uniform vec4 emitterParams[32]; // lifetime, size, texture page
+// texture page bound for this draw; other emitters' particles are culled
+uniform float page;
 
 void main()
 {
-    float scale = 10.0f;
-    TexCoords = vertex.zw;
-    ParticleColor = color;
-    gl_Position = projection * vec4((vertex.xy * scale) + offset, 0.0, 1.0);
+    int e = int(emitter);
+    vec4 params = emitterParams[e];
+    // other pages are drawn separately; GPU-simulated slots may hold dead particles
+    if (params.z != page || life <= 0.0)
+    {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0); // outside the clip volume
+        return;
+    }
+    float age = clamp(1.0 - life / params.x, 0.0, 1.0);
+    vec4 uv = emitterUV[e];
+    TexCoords = mix(uv.xy, uv.zw, vertex.zw);
+    ParticleColor = mix(emitterStart[e], emitterEnd[e], age) * vec4(tintR, tintG, tintB, tintA);
+    gl_Position = projection * vec4((vertex.xy * params.y) + vec2(positionX, positionY), 0.0, 1.0);
 }
\ No newline at end of file
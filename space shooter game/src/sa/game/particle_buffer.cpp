@@ -0,0 +1,159 @@
+#include "particle_buffer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLE_KERNEL_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PARTICLE_KERNEL_SSE
+#endif
+
+// posición del bit menos significativo a 1 (mask != 0)
+static inline unsigned int lowestBit(int mask)
+{
+    unsigned int bit = 0;
+    while (!(mask & 1))
+    {
+        mask >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+ParticleBuffer::ParticleBuffer(unsigned int capacity, ParticleOverflow overflow)
+    : Overflow(overflow), Stats(), storage(nullptr), capacity(0), count(0), recycleCursor(0)
+{
+    this->Reserve(capacity);
+}
+
+ParticleBuffer::~ParticleBuffer()
+{
+    std::free(this->storage);
+}
+
+int ParticleBuffer::Spawn()
+{
+    if (this->count == this->capacity)
+    {
+        if (this->Overflow == PARTICLE_GROW && this->capacity > 0)
+            this->Reserve(this->capacity * 2);
+        else if (this->Overflow == PARTICLE_RECYCLE && this->count > 0)
+        {
+            // Las plazas bajas son las más antiguas salvo donde swap-remove movió otra;
+            // recorrerlas por turnos reparte el reciclaje sin buscar la de menos vida
+            this->recycleCursor = this->recycleCursor < this->count ? this->recycleCursor : 0;
+            ++this->Stats.Spawned;
+            ++this->Stats.Recycled;
+            return static_cast<int>(this->recycleCursor++);
+        }
+        else
+        {
+            ++this->Stats.Rejected;
+            return -1;
+        }
+    }
+    ++this->Stats.Spawned;
+    return static_cast<int>(this->count++);
+}
+
+void ParticleBuffer::ResetStats()
+{
+    this->Stats = ParticleStats();
+}
+
+void ParticleBuffer::Reserve(unsigned int capacity)
+{
+    if (capacity <= this->capacity && this->storage)
+        return;
+    // 10 arrays con la capacidad redondeada a 8 floats (un registro AVX) en un solo bloque alineado a 32
+    std::size_t stride = (static_cast<std::size_t>(capacity) + 7) & ~static_cast<std::size_t>(7);
+    void *storage = std::malloc(stride * 10 * sizeof(float) + 31);
+    float *base = reinterpret_cast<float*>((reinterpret_cast<std::uintptr_t>(storage) + 31) & ~static_cast<std::uintptr_t>(31));
+    float **arrays[] = { &this->PositionX, &this->PositionY, &this->VelocityX, &this->VelocityY,
+                         &this->ColorR, &this->ColorG, &this->ColorB, &this->ColorA, &this->Life, &this->Tag };
+    for (float **array : arrays)
+    {
+        if (this->count > 0)
+            std::memcpy(base, *array, this->count * sizeof(float));
+        *array = base;
+        base += stride;
+    }
+    std::free(this->storage);
+    this->storage = storage;
+    this->capacity = capacity;
+    this->dead.resize(capacity);
+}
+
+void ParticleBuffer::Update(float dt)
+{
+    // los arrays en locales: un store a float podría cambiar los punteros de this, y sin esto
+    // el compilador los vuelve a leer en cada iteración
+    float *life = this->Life, *x = this->PositionX, *y = this->PositionY;
+    const float *vx = this->VelocityX, *vy = this->VelocityY;
+    // dead tiene una plaza por partícula: se escribe sin comprobar capacidad
+    unsigned int *dead = this->dead.data();
+    unsigned int n = this->count, i = 0, deaths = 0;
+#if defined(PARTICLE_KERNEL_AVX)
+    __m256 vdt = _mm256_set1_ps(dt);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 l = _mm256_sub_ps(_mm256_load_ps(life + i), vdt);
+        _mm256_store_ps(life + i, l);
+        _mm256_store_ps(x + i, _mm256_sub_ps(_mm256_load_ps(x + i), _mm256_mul_ps(_mm256_load_ps(vx + i), vdt)));
+        _mm256_store_ps(y + i, _mm256_sub_ps(_mm256_load_ps(y + i), _mm256_mul_ps(_mm256_load_ps(vy + i), vdt)));
+        // una comparación por bloque: casi nunca muere ninguna
+        for (int mask = _mm256_movemask_ps(_mm256_cmp_ps(l, _mm256_setzero_ps(), _CMP_LE_OQ)); mask; mask &= mask - 1)
+            dead[deaths++] = i + lowestBit(mask);
+    }
+#elif defined(PARTICLE_KERNEL_SSE)
+    __m128 vdt = _mm_set1_ps(dt);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 l = _mm_sub_ps(_mm_load_ps(life + i), vdt);
+        _mm_store_ps(life + i, l);
+        _mm_store_ps(x + i, _mm_sub_ps(_mm_load_ps(x + i), _mm_mul_ps(_mm_load_ps(vx + i), vdt)));
+        _mm_store_ps(y + i, _mm_sub_ps(_mm_load_ps(y + i), _mm_mul_ps(_mm_load_ps(vy + i), vdt)));
+        // una comparación por bloque: casi nunca muere ninguna
+        for (int mask = _mm_movemask_ps(_mm_cmple_ps(l, _mm_setzero_ps())); mask; mask &= mask - 1)
+            dead[deaths++] = i + lowestBit(mask);
+    }
+#endif
+    // cola que no llena un registro (o todo, sin SIMD)
+    for (; i < n; ++i)
+    {
+        life[i] -= dt;
+        x[i] -= vx[i] * dt;
+        y[i] -= vy[i] * dt;
+        if (life[i] <= 0.0f)
+            dead[deaths++] = i;
+    }
+
+    // Compacta de la mayor a la menor: las muertas posteriores ya se quitaron,
+    // así que la última del rango siempre está viva (o es la propia muerta).
+    // Cada muerta toca una línea de caché fría en cada uno de los 10 arrays: con muchas
+    // partículas es lo que más cuesta del Update, más que el propio recorrido
+    float *arrays[] = { x, y, this->VelocityX, this->VelocityY, this->ColorR, this->ColorG, this->ColorB, this->ColorA, life, this->Tag };
+    while (deaths > 0)
+    {
+        i = dead[--deaths];
+        --n;
+        for (float *array : arrays)
+            array[i] = array[n];
+    }
+    this->count = n;
+}
+
+const char *ParticleBuffer::Kernel()
+{
+#if defined(PARTICLE_KERNEL_AVX)
+    return "AVX";
+#elif defined(PARTICLE_KERNEL_SSE)
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,61 @@
+#ifndef PARTICLE_BUFFER_H
+#define PARTICLE_BUFFER_H
+#include <cstddef>
+#include <vector>
+
+// Qué hace Spawn cuando todas las plazas están ocupadas
+enum ParticleOverflow {
+    PARTICLE_DROP,    // rechaza la partícula nueva
+    PARTICLE_RECYCLE, // sustituye una viva, por turnos, empezando por las que llevan más tiempo en su plaza
+    PARTICLE_GROW     // duplica la capacidad
+};
+
+// Contadores de Spawn; se reinician con ResetStats() al inicio de cada tick
+struct ParticleStats {
+    unsigned int Spawned  = 0;
+    unsigned int Rejected = 0;
+    unsigned int Recycled = 0;
+};
+
+// Partículas en estructura de arrays: cada campo va en su propio array alineado a 32 bytes
+// para que Update los recorra con SSE/AVX. Las partículas vivas ocupan siempre [0, Count()):
+// las que mueren se sustituyen por la última viva (swap-remove), así nunca se visitan muertas.
+// No usa GL, por eso también lo enlaza la herramienta particle_benchmark.
+class ParticleBuffer
+{
+public:
+
+    float *PositionX, *PositionY;
+    float *VelocityX, *VelocityY;
+    float *ColorR, *ColorG, *ColorB, *ColorA;
+    float *Life;
+    float *Tag; // dato libre que acompaña a la partícula al compactar (ParticleSystem guarda su emisor)
+
+    ParticleOverflow Overflow;
+    ParticleStats    Stats;
+
+    ParticleBuffer(unsigned int capacity, ParticleOverflow overflow = PARTICLE_RECYCLE);
+    ~ParticleBuffer();
+    ParticleBuffer(const ParticleBuffer &) = delete;
+    ParticleBuffer &operator=(const ParticleBuffer &) = delete;
+    unsigned int Count() const { return this->count; }
+    unsigned int Capacity() const { return this->capacity; }
+    // índice para una partícula nueva en O(1); -1 si está lleno y Overflow es PARTICLE_DROP
+    int  Spawn();
+    void ResetStats();
+    // amplía los arrays conservando las partículas vivas
+    void Reserve(unsigned int capacity);
+    // resta vida y mueve las vivas; después compacta las que han muerto
+    void Update(float dt);
+    // conjunto de instrucciones con el que se compiló el núcleo de Update
+    static const char *Kernel();
+
+private:
+
+    void        *storage;
+    unsigned int capacity, count;
+    unsigned int recycleCursor;
+    std::vector<unsigned int> dead; // una plaza por partícula; Update anota las que mueren en orden creciente
+};
+
+#endif
@@ -0,0 +1,370 @@
+#include "particle_system.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+// Aleatorio uniforme en [-1, 1]
+static float randomSigned()
+{
+    return (rand() % 2001 - 1000) / 1000.0f;
+}
+
+ParticleSystem::ParticleSystem(Shader shader, unsigned int capacity, ParticleOverflow overflow)
+    : particles(capacity, overflow), totals(), peakCount(0), shader(shader), VAO(0), quadVBO(0), instanceVBO(0), instanceCapacity(0)
+{
+    // Resuelve una sola vez las ubicaciones de los uniformes usados en Draw
+    this->uvUniform = this->shader.GetUniform("emitterUV");
+    this->startColorUniform = this->shader.GetUniform("emitterStart");
+    this->endColorUniform = this->shader.GetUniform("emitterEnd");
+    this->paramsUniform = this->shader.GetUniform("emitterParams");
+    this->pageUniform = this->shader.GetUniform("page");
+    this->simulation.ID = 0;
+    this->init();
+}
+
+ParticleSystem::~ParticleSystem()
+{
+    for (EmitterSlot &slot : this->emitters)
+        this->releaseGPU(slot);
+    glDeleteVertexArrays(1, &this->VAO);
+    glDeleteBuffers(1, &this->quadVBO);
+    glDeleteBuffers(1, &this->instanceVBO);
+}
+
+void ParticleSystem::EnableGPU(Shader simulation)
+{
+    int linked = 0;
+    if (simulation.ID != 0)
+        glGetProgramiv(simulation.ID, GL_LINK_STATUS, &linked);
+    if (!linked)
+        return; // se sigue simulando en CPU
+    this->simulation = simulation;
+    this->simulationUniforms.DeltaTime = simulation.GetUniform("dt");
+    this->simulationUniforms.Seed = simulation.GetUniform("seed");
+    this->simulationUniforms.Position = simulation.GetUniform("emitterPosition");
+    this->simulationUniforms.Velocity = simulation.GetUniform("emitterVelocity");
+    this->simulationUniforms.VelocitySpread = simulation.GetUniform("velocitySpread");
+    this->simulationUniforms.PositionSpread = simulation.GetUniform("positionSpread");
+    this->simulationUniforms.Lifetime = simulation.GetUniform("lifetime");
+    this->simulationUniforms.Brightness = simulation.GetUniform("brightness");
+    this->simulationUniforms.SpawnStart = simulation.GetUniform("spawnStart");
+    this->simulationUniforms.SpawnCount = simulation.GetUniform("spawnCount");
+    this->simulationUniforms.Capacity = simulation.GetUniform("capacity");
+}
+
+int ParticleSystem::CreateEmitter(const ParticleEmitter &emitter)
+{
+    for (unsigned int i = 0; i < MAX_PARTICLE_EMITTERS; ++i)
+    {
+        EmitterSlot &slot = this->emitters[i];
+        if (slot.Used)
+            continue;
+        slot = EmitterSlot();
+        slot.Emitter = emitter;
+        slot.Used = true;
+        slot.Emitting = true;
+        return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void ParticleSystem::KillEmitter(int id)
+{
+    EmitterSlot &slot = this->emitters[id];
+    slot.Emitting = false;
+    slot.Pending = 0;
+    slot.Linger = slot.Emitter.Lifetime; // ninguna partícula suya vive más que esto
+}
+
+ParticleEmitter &ParticleSystem::Emitter(int id)
+{
+    return this->emitters[id].Emitter;
+}
+
+void ParticleSystem::Burst(int id, unsigned int count)
+{
+    if (this->emitters[id].Emitting)
+        this->emitters[id].Pending += count;
+}
+
+void ParticleSystem::Update(float dt)
+{
+    // el tick anterior se acumula para Report()
+    this->totals.Spawned += this->particles.Stats.Spawned;
+    this->totals.Rejected += this->particles.Stats.Rejected;
+    this->totals.Recycled += this->particles.Stats.Recycled;
+    this->particles.ResetStats();
+    // Altas de todos los emisores
+    for (unsigned int i = 0; i < MAX_PARTICLE_EMITTERS; ++i)
+    {
+        EmitterSlot &slot = this->emitters[i];
+        if (!slot.Used)
+            continue;
+        bool gpu = slot.Emitter.GPUParticles > 0 && this->simulation.ID != 0;
+        if (gpu && slot.GPU.Capacity == 0)
+            this->createGPU(slot);
+        if (!slot.Emitting)
+        {
+            // El hueco se libera cuando ya no puede quedar ninguna partícula con su índice
+            slot.Linger -= dt;
+            if (gpu)
+                this->updateGPU(slot, dt, 0);
+            if (slot.Linger <= 0.0f)
+            {
+                slot.Used = false;
+                this->releaseGPU(slot);
+            }
+            continue;
+        }
+        slot.Accumulator += slot.Emitter.Rate * dt;
+        unsigned int count = static_cast<unsigned int>(slot.Accumulator);
+        slot.Accumulator -= count;
+        if (gpu)
+            this->updateGPU(slot, dt, count + slot.Pending);
+        else
+            this->spawn(i, count + slot.Pending);
+        slot.Pending = 0;
+    }
+    this->peakCount = std::max(this->peakCount, this->particles.Count());
+    // Todas las partículas del pool en una pasada (SIMD + swap-remove)
+    this->particles.Update(dt);
+}
+
+void ParticleSystem::Report()
+{
+    const ParticleStats &tick = this->particles.Stats; // el último tick aún no se ha sumado
+    unsigned int gpuEmitters = 0;
+    for (const EmitterSlot &slot : this->emitters)
+        gpuEmitters += slot.GPU.Capacity > 0 ? 1 : 0;
+    std::cout << "PARTICLES: " << this->particles.Count() << " live, peak " << this->peakCount << " of " << this->particles.Capacity() << " slots, "
+              << this->totals.Spawned + tick.Spawned << " spawned, " << this->totals.Rejected + tick.Rejected << " rejected, "
+              << this->totals.Recycled + tick.Recycled << " recycled; " << gpuEmitters << " emitter(s) on GPU" << std::endl;
+    this->totals = ParticleStats();
+    this->particles.ResetStats();
+    this->peakCount = this->particles.Count();
+}
+
+// Dibuja el pool: una llamada instanciada por página de textura usada por los emisores
+void ParticleSystem::Draw()
+{
+    const ParticleBuffer &p = this->particles;
+    unsigned int count = p.Count(); // Solo hay partículas activas en [0, Count())
+    bool gpu = false;
+    for (const EmitterSlot &slot : this->emitters)
+        gpu = gpu || slot.GPU.Capacity > 0;
+    if (count == 0 && !gpu)
+        return;
+
+    // Tabla de emisores para particle.vs: rectángulo UV, rampa de color y (vida, tamaño, página)
+    glm::vec4 uv[MAX_PARTICLE_EMITTERS], start[MAX_PARTICLE_EMITTERS], end[MAX_PARTICLE_EMITTERS], params[MAX_PARTICLE_EMITTERS];
+    this->pages.clear();
+    for (unsigned int i = 0; i < MAX_PARTICLE_EMITTERS; ++i)
+    {
+        const EmitterSlot &slot = this->emitters[i];
+        const ParticleEmitter &emitter = slot.Emitter;
+        uv[i] = emitter.Texture.UV;
+        start[i] = emitter.StartColor;
+        end[i] = emitter.EndColor;
+        params[i] = glm::vec4(emitter.Lifetime, emitter.Size, static_cast<float>(emitter.Texture.ID), 0.0f);
+        if (slot.Used && slot.GPU.Capacity == 0 && std::find(this->pages.begin(), this->pages.end(), emitter.Texture.ID) == this->pages.end())
+            this->pages.push_back(emitter.Texture.ID);
+    }
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE); // Configura la función de mezcla
+    this->shader.Use();
+    glUniform4fv(this->uvUniform.Location, MAX_PARTICLE_EMITTERS, &uv[0].x);
+    glUniform4fv(this->startColorUniform.Location, MAX_PARTICLE_EMITTERS, &start[0].x);
+    glUniform4fv(this->endColorUniform.Location, MAX_PARTICLE_EMITTERS, &end[0].x);
+    glUniform4fv(this->paramsUniform.Location, MAX_PARTICLE_EMITTERS, &params[0].x);
+    glActiveTexture(GL_TEXTURE0);
+    if (count > 0)
+    {
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->instanceVBO);
+        if (p.Capacity() != this->instanceCapacity) // el pool creció (PARTICLE_GROW) o es el primer frame
+        {
+            this->instanceCapacity = p.Capacity();
+            this->bindInstanceStreams();
+        }
+        // Huerfaniza el buffer para no esperar al frame anterior y copia cada array SoA a su tramo, sin reempaquetar
+        const float *streams[] = { p.PositionX, p.PositionY, p.ColorR, p.ColorG, p.ColorB, p.ColorA, p.Life, p.Tag };
+        std::size_t section = this->instanceCapacity * sizeof(float);
+        glBufferData(GL_ARRAY_BUFFER, 8 * section, NULL, GL_STREAM_DRAW);
+        for (unsigned int i = 0; i < 8; ++i)
+            glBufferSubData(GL_ARRAY_BUFFER, i * section, count * sizeof(float), streams[i]);
+        for (unsigned int page : this->pages)
+        {
+            // el shader descarta las partículas de emisores de otras páginas
+            this->shader.SetFloat(this->pageUniform, static_cast<float>(page));
+            glBindTexture(GL_TEXTURE_2D, page);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+        }
+    }
+    // Emisores en GPU: se dibujan directamente desde su buffer actual
+    for (unsigned int i = 0; i < MAX_PARTICLE_EMITTERS; ++i)
+        if (this->emitters[i].GPU.Capacity > 0)
+            this->drawGPU(i);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Restaura la función de mezcla original
+}
+
+// Da de alta count partículas del emisor slot con su dispersión aleatoria
+void ParticleSystem::spawn(unsigned int slot, unsigned int count)
+{
+    ParticleBuffer &p = this->particles;
+    const ParticleEmitter &emitter = this->emitters[slot].Emitter;
+    for (unsigned int n = 0; n < count; ++n)
+    {
+        int index = p.Spawn();
+        if (index < 0)
+            continue; // PARTICLE_DROP: queda contada en Stats().Rejected
+        float brightness = 1.0f + emitter.Brightness * randomSigned();
+        p.PositionX[index] = emitter.Position.x + emitter.PositionSpread * randomSigned();
+        p.PositionY[index] = emitter.Position.y + emitter.PositionSpread * randomSigned();
+        // ParticleBuffer resta la velocidad al integrar
+        p.VelocityX[index] = -(emitter.Velocity.x + emitter.VelocitySpread.x * randomSigned());
+        p.VelocityY[index] = -(emitter.Velocity.y + emitter.VelocitySpread.y * randomSigned());
+        p.ColorR[index] = p.ColorG[index] = p.ColorB[index] = brightness;
+        p.ColorA[index] = 1.0f;
+        p.Life[index] = emitter.Lifetime;
+        p.Tag[index] = static_cast<float>(slot);
+    }
+}
+
+void ParticleSystem::init()
+{
+    float particle_quad[] = {
+        0.0f, 1.0f, 0.0f, 1.0f,
+        1.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+
+        0.0f, 1.0f, 0.0f, 1.0f,
+        1.0f, 1.0f, 1.0f, 1.0f,
+        1.0f, 0.0f, 1.0f, 0.0f
+    };
+    glGenVertexArrays(1, &this->VAO);
+    glGenBuffers(1, &this->quadVBO);
+    glBindVertexArray(this->VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, this->quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(particle_quad), particle_quad, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    // Atributos por instancia de particle.vs (posición, tinte, vida y emisor); sus punteros se fijan en Draw
+    glGenBuffers(1, &this->instanceVBO);
+    for (unsigned int location = 1; location <= 8; ++location)
+    {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    glBindVertexArray(0);
+}
+
+// Apunta cada atributo por instancia a su tramo de instanceVBO (un tramo por array de ParticleBuffer)
+void ParticleSystem::bindInstanceStreams()
+{
+    std::size_t section = this->instanceCapacity * sizeof(float);
+    for (unsigned int i = 0; i < 8; ++i)
+        glVertexAttribPointer(1 + i, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(i * section));
+}
+
+// Par de buffers con todas las plazas muertas (vida 0) y sus VAO de simulación y de dibujo
+void ParticleSystem::createGPU(EmitterSlot &slot)
+{
+    GPUState &gpu = slot.GPU;
+    gpu.Capacity = slot.Emitter.GPUParticles;
+    gpu.Current = 0;
+    gpu.Cursor = 0;
+    std::vector<float> initial(gpu.Capacity * 6, 0.0f);
+    const GLsizei stride = 6 * sizeof(float); // posición, velocidad, vida, tinte
+    glGenBuffers(2, gpu.Buffers);
+    glGenVertexArrays(2, gpu.UpdateVAO);
+    glGenVertexArrays(2, gpu.DrawVAO);
+    for (unsigned int b = 0; b < 2; ++b)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, gpu.Buffers[b]);
+        glBufferData(GL_ARRAY_BUFFER, initial.size() * sizeof(float), initial.data(), GL_DYNAMIC_COPY);
+        // entrada de particle_update.vs
+        glBindVertexArray(gpu.UpdateVAO[b]);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
+        // atributos por instancia de particle.vs; el tinte alfa (6) y el emisor (8) son valores genéricos
+        glBindVertexArray(gpu.DrawVAO[b]);
+        glBindBuffer(GL_ARRAY_BUFFER, this->quadVBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glBindBuffer(GL_ARRAY_BUFFER, gpu.Buffers[b]);
+        const unsigned int locations[] = { 1, 2, 3, 4, 5, 7 };
+        const unsigned int offsets[] = { 0, 1, 5, 5, 5, 4 };
+        for (unsigned int i = 0; i < 6; ++i)
+        {
+            glEnableVertexAttribArray(locations[i]);
+            glVertexAttribPointer(locations[i], 1, GL_FLOAT, GL_FALSE, stride, (void*)(offsets[i] * sizeof(float)));
+            glVertexAttribDivisor(locations[i], 1);
+        }
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ParticleSystem::releaseGPU(EmitterSlot &slot)
+{
+    GPUState &gpu = slot.GPU;
+    if (gpu.Capacity == 0)
+        return;
+    glDeleteBuffers(2, gpu.Buffers);
+    glDeleteVertexArrays(2, gpu.UpdateVAO);
+    glDeleteVertexArrays(2, gpu.DrawVAO);
+    gpu = GPUState();
+}
+
+// Un paso de simulación: lee el buffer actual, escribe el otro con transform feedback y los intercambia
+void ParticleSystem::updateGPU(EmitterSlot &slot, float dt, unsigned int count)
+{
+    GPUState &gpu = slot.GPU;
+    const ParticleEmitter &emitter = slot.Emitter;
+    count = count < gpu.Capacity ? count : gpu.Capacity;
+    Shader &simulation = this->simulation;
+    simulation.Use();
+    simulation.SetFloat(this->simulationUniforms.DeltaTime, dt);
+    simulation.SetFloat(this->simulationUniforms.Seed, (rand() % 10000) / 100.0f);
+    simulation.SetVector2f(this->simulationUniforms.Position, emitter.Position);
+    simulation.SetVector2f(this->simulationUniforms.Velocity, emitter.Velocity);
+    simulation.SetVector2f(this->simulationUniforms.VelocitySpread, emitter.VelocitySpread);
+    simulation.SetFloat(this->simulationUniforms.PositionSpread, emitter.PositionSpread);
+    simulation.SetFloat(this->simulationUniforms.Lifetime, emitter.Lifetime);
+    simulation.SetFloat(this->simulationUniforms.Brightness, emitter.Brightness);
+    simulation.SetInteger(this->simulationUniforms.SpawnStart, static_cast<int>(gpu.Cursor));
+    simulation.SetInteger(this->simulationUniforms.SpawnCount, static_cast<int>(count));
+    simulation.SetInteger(this->simulationUniforms.Capacity, static_cast<int>(gpu.Capacity));
+    gpu.Cursor = (gpu.Cursor + count) % gpu.Capacity;
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(gpu.UpdateVAO[gpu.Current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, gpu.Buffers[1 - gpu.Current]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, gpu.Capacity);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    gpu.Current = 1 - gpu.Current;
+}
+
+// Dibuja todas las plazas del emisor index; particle.vs descarta las muertas
+void ParticleSystem::drawGPU(unsigned int index)
+{
+    const EmitterSlot &slot = this->emitters[index];
+    this->shader.SetFloat(this->pageUniform, static_cast<float>(slot.Emitter.Texture.ID));
+    glBindTexture(GL_TEXTURE_2D, slot.Emitter.Texture.ID);
+    glBindVertexArray(slot.GPU.DrawVAO[slot.GPU.Current]);
+    glVertexAttrib1f(6, 1.0f);
+    glVertexAttrib1f(8, static_cast<float>(index));
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, slot.GPU.Capacity);
+}
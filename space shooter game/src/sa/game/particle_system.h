@@ -0,0 +1,112 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "shader.h"
+#include "texture.h"
+#include "particle_buffer.h"
+
+// Debe coincidir con el tamaño de los arrays de emisores de particle.vs
+const unsigned int MAX_PARTICLE_EMITTERS = 32;
+// Salidas de particle_update.vs en el orden del vértice de GPU (posición, velocidad, vida, tinte)
+const std::vector<const char*> PARTICLE_FEEDBACK_VARYINGS = { "outPosition", "outVelocity", "outLife", "outTint" };
+
+// Descripción de un emisor: solo datos, sus partículas viven en el pool de ParticleSystem
+struct ParticleEmitter {
+    glm::vec2 Position       = glm::vec2(0.0f);
+    glm::vec2 Velocity       = glm::vec2(0.0f); // velocidad inicial de cada partícula
+    glm::vec2 VelocitySpread = glm::vec2(0.0f); // ± aleatorio por componente
+    float     PositionSpread = 0.0f;            // ± aleatorio alrededor de Position
+    float     Rate           = 0.0f;            // partículas por segundo (0: solo con Burst)
+    float     Lifetime       = 1.0f;            // segundos
+    float     Size           = 10.0f;
+    float     Brightness     = 0.0f;            // ± aleatorio sobre el RGB de cada partícula
+    // > 0: simula el emisor en GPU (transform feedback) con este número de plazas propias.
+    // Sin EnableGPU o si el programa no enlazó, el emisor usa el pool de CPU
+    unsigned int GPUParticles = 0;
+    glm::vec4 StartColor     = glm::vec4(1.0f); // rampa de color del nacimiento a la muerte
+    glm::vec4 EndColor       = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+    Texture2D Texture;
+};
+
+// Un único pool de partículas (ParticleBuffer) compartido por muchos emisores ligeros.
+// Update avanza todos los emisores y todas las partículas en una pasada; Draw sube el pool
+// una vez y lo dibuja con una llamada instanciada por página de textura (una si los emisores
+// comparten página del atlas). La rampa de color se evalúa en particle.vs con la vida restante.
+// Los emisores con GPUParticles tienen su propio par de buffers que se integra en GPU con
+// transform feedback (particle_update.vs), sin pasar por la CPU ni subirse cada frame.
+class ParticleSystem
+{
+public:
+
+    ParticleSystem(Shader shader, unsigned int capacity, ParticleOverflow overflow = PARTICLE_RECYCLE);
+    ~ParticleSystem();
+    // programa de particle_update.vs (ResourceManager::LoadFeedbackShader con PARTICLE_FEEDBACK_VARYINGS)
+    void EnableGPU(Shader simulation);
+    // -1 si ya hay MAX_PARTICLE_EMITTERS emisores en uso
+    int  CreateEmitter(const ParticleEmitter &emitter);
+    // deja de emitir; sus partículas acaban su vida y después el hueco se reutiliza
+    void KillEmitter(int id);
+    // descriptor del emisor para moverlo o cambiarlo entre frames
+    ParticleEmitter &Emitter(int id);
+    // count partículas de golpe en el próximo Update (explosiones, impactos)
+    void Burst(int id, unsigned int count);
+    void Update(float dt);
+    void Draw();
+    // partículas vivas del pool de CPU (las de GPU no se leen de vuelta)
+    unsigned int Count() const { return this->particles.Count(); }
+    // altas, rechazos y reciclajes del último Update
+    const ParticleStats &Stats() const { return this->particles.Stats; }
+    // ocupación máxima del pool y altas, rechazos y reciclajes desde el último Report; después
+    // pone los totales a cero
+    void Report();
+
+private:
+
+    // par de buffers de un emisor en GPU: se lee de Current y se escribe en el otro
+    struct GPUState {
+        unsigned int Buffers[2] = { 0, 0 };
+        unsigned int UpdateVAO[2] = { 0, 0 };
+        unsigned int DrawVAO[2] = { 0, 0 };
+        unsigned int Capacity = 0; // 0: sin recursos de GPU
+        unsigned int Current = 0;
+        unsigned int Cursor = 0;   // siguiente plaza candidata a reaparecer
+    };
+    struct EmitterSlot {
+        ParticleEmitter Emitter;
+        bool            Used = false;     // hueco ocupado (emitiendo o esperando a que mueran sus partículas)
+        bool            Emitting = false;
+        float           Accumulator = 0.0f; // fracción de partícula pendiente de Rate * dt
+        float           Linger = 0.0f;      // tras KillEmitter: tiempo hasta que no quede ninguna suya
+        unsigned int    Pending = 0;        // partículas pedidas con Burst
+        GPUState        GPU;
+    };
+    ParticleBuffer particles;
+    ParticleStats  totals;    // ticks anteriores al último Update, para Report
+    unsigned int   peakCount; // máximo de partículas de CPU vivas tras las altas de un tick
+    EmitterSlot    emitters[MAX_PARTICLE_EMITTERS];
+    Shader         shader;
+    UniformLocation uvUniform, startColorUniform, endColorUniform, paramsUniform, pageUniform;
+    Shader         simulation; // ID 0: sin backend de GPU
+    struct {
+        UniformLocation DeltaTime, Seed, Position, Velocity, VelocitySpread, PositionSpread,
+                        Lifetime, Brightness, SpawnStart, SpawnCount, Capacity;
+    } simulationUniforms;
+    unsigned int   VAO;
+    unsigned int   quadVBO;
+    unsigned int   instanceVBO;
+    unsigned int   instanceCapacity; // partículas que caben en instanceVBO con los punteros actuales
+    std::vector<unsigned int> pages;
+    void init();
+    void bindInstanceStreams();
+    void spawn(unsigned int slot, unsigned int count);
+    void createGPU(EmitterSlot &slot);
+    void releaseGPU(EmitterSlot &slot);
+    void updateGPU(EmitterSlot &slot, float dt, unsigned int count);
+    void drawGPU(unsigned int index);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#version 330 core
+// GPU particle step for ParticleSystem: one vertex per particle slot, captured with
+// transform feedback into the other buffer of the pair (see ParticleSystem::updateGPU)
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 velocity;
+layout (location = 2) in float life;
+layout (location = 3) in float tint;
+
+out vec2  outPosition;
+out vec2  outVelocity;
+out float outLife;
+out float outTint;
+
+uniform float dt;
+uniform float seed;
+// emitter
+uniform vec2  emitterPosition;
+uniform vec2  emitterVelocity;
+uniform vec2  velocitySpread;
+uniform float positionSpread;
+uniform float lifetime;
+uniform float brightness;
+// dead slots in [spawnStart, spawnStart + spawnCount) (wrapping) are respawned this step
+uniform int   spawnStart;
+uniform int   spawnCount;
+uniform int   capacity;
+
+// pseudo-random value in [-1, 1]
+float random(float n)
+{
+    return fract(sin(n * 12.9898 + seed * 78.233) * 43758.5453) * 2.0 - 1.0;
+}
+
+void main()
+{
+    float remaining = life - dt;
+    int window = (gl_VertexID - spawnStart + capacity) % capacity;
+    if (remaining <= 0.0 && window < spawnCount)
+    {
+        float id = float(gl_VertexID);
+        outPosition = emitterPosition + positionSpread * vec2(random(id), random(id + 0.5));
+        outVelocity = emitterVelocity + velocitySpread * vec2(random(id + 0.25), random(id + 0.75));
+        outLife = lifetime;
+        outTint = 1.0 + brightness * random(id + 0.125);
+    }
+    else
+    {
+        outPosition = position + velocity * dt;
+        outVelocity = velocity;
+        outLife = max(remaining, -1.0);
+        outTint = tint;
+    }
+}
\ No newline at end of file
@@ -34,6 +34,14 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int hei
     // Inicializa los datos de renderizado
     this->initRenderData();
 
+    // Resuelve las ubicaciones de los uniformes que se actualizan cada frame
+    this->timeUniform = this->PostProcessingShader.GetUniform("time");
+    this->confuseUniform = this->PostProcessingShader.GetUniform("confuse");
+    this->chaosUniform = this->PostProcessingShader.GetUniform("chaos");
+    this->shakeUniform = this->PostProcessingShader.GetUniform("shake");
+    this->parallaxUniform = this->PostProcessingShader.GetUniform("parallax");
+    this->parallaxSlowUniform = this->PostProcessingShader.GetUniform("parallaxslow");
+
     // Configura los uniformes del shader de post-procesamiento
     this->PostProcessingShader.SetInteger("scene", 0, true);
 
@@ -50,7 +58,7 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int hei
         {  0.0f,   -offset  },  // abajo-centro
         {  offset, -offset  }   // abajo-derecha    
     };
-    glUniform2fv(glGetUniformLocation(this->PostProcessingShader.ID, "offsets"), 9, (float*)offsets);
+    glUniform2fv(this->PostProcessingShader.GetUniform("offsets").Location, 9, (float*)offsets);
 
     // Define el kernel para detección de bordes
     int edge_kernel[9] = {
@@ -58,7 +66,7 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int hei
         -1,  8, -1,
         -1, -1, -1
     };
-    glUniform1iv(glGetUniformLocation(this->PostProcessingShader.ID, "edge_kernel"), 9, edge_kernel);
+    glUniform1iv(this->PostProcessingShader.GetUniform("edge_kernel").Location, 9, edge_kernel);
 
     // Define el kernel para el desenfoque (blur)
     float blur_kernel[9] = {
@@ -66,7 +74,7 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int hei
         2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
         1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
     };
-    glUniform1fv(glGetUniformLocation(this->PostProcessingShader.ID, "blur_kernel"), 9, blur_kernel);
+    glUniform1fv(this->PostProcessingShader.GetUniform("blur_kernel").Location, 9, blur_kernel);
 }
 
 // Inicia el proceso de renderizado
@@ -90,12 +98,12 @@ void PostProcessor::EndRender()
 void PostProcessor::Render(float time)
 {
     this->PostProcessingShader.Use();
-    this->PostProcessingShader.SetFloat("time", time);
-    this->PostProcessingShader.SetInteger("confuse", this->Confuse);
-    this->PostProcessingShader.SetInteger("chaos", this->Chaos);
-    this->PostProcessingShader.SetInteger("shake", this->Shake);
-    this->PostProcessingShader.SetInteger("parallax", this->Parallax);
-    this->PostProcessingShader.SetInteger("parallaxslow", this->ParallaxSlow);
+    this->PostProcessingShader.SetFloat(this->timeUniform, time);
+    this->PostProcessingShader.SetInteger(this->confuseUniform, this->Confuse);
+    this->PostProcessingShader.SetInteger(this->chaosUniform, this->Chaos);
+    this->PostProcessingShader.SetInteger(this->shakeUniform, this->Shake);
+    this->PostProcessingShader.SetInteger(this->parallaxUniform, this->Parallax);
+    this->PostProcessingShader.SetInteger(this->parallaxSlowUniform, this->ParallaxSlow);
     glActiveTexture(GL_TEXTURE0);
     this->Texture.Bind();
     glBindVertexArray(this->VAO);
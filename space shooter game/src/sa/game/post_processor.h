@@ -24,6 +24,7 @@ private:
     unsigned int MSFBO, FBO;
     unsigned int RBO;
     unsigned int VAO;
+    UniformLocation timeUniform, confuseUniform, chaosUniform, shakeUniform, parallaxUniform, parallaxSlowUniform;
     void initRenderData();
 };
 
@@ -2,6 +2,8 @@
 #include <GLFW/glfw3.h>
 #include "game.h"
 #include "resource_manager.h"
+#include "texture_cache.h"
+#include "fixed_timestep.h"
 #include <iostream>
 
 // Callback para cambiar el tamaño del framebuffer
@@ -14,6 +16,11 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 const unsigned int SCREEN_WIDTH = 1800;
 const unsigned int SCREEN_HEIGHT = 1000;
 
+// Frecuencia de la simulación (ticks por segundo), independiente de la de dibujo, y ticks que se
+// pueden simular en un frame para recuperar un atraso
+const float SIMULATION_RATE = 60.0f;
+const unsigned int MAX_CATCH_UP_TICKS = 5;
+
 // Inicialización del juego con las dimensiones de pantalla
 Game Breakout(SCREEN_WIDTH, SCREEN_HEIGHT);
 
@@ -21,6 +28,8 @@ int main(int argc, char *argv[])
 {
     // Inicializa GLFW
     glfwInit();
+    // Referencia para medir el tiempo hasta el primer frame
+    double startTime = glfwGetTime();
     // Especifica la versión de OpenGL que se va a utilizar (3.3)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -54,12 +63,28 @@ int main(int argc, char *argv[])
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    // Inicializa los recursos y el estado del juego
-    Breakout.Init();
+    // Inicializa los recursos y el estado del juego; mientras tanto dibuja una barra de progreso
+    // con glScissor + glClear, que no necesita shaders ni texturas
+    Breakout.Init([window](float progress) {
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(SCREEN_WIDTH / 4, SCREEN_HEIGHT / 2 - 10, static_cast<int>(SCREEN_WIDTH / 2 * progress), 20);
+        glClearColor(0.0f, 0.8f, 1.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDisable(GL_SCISSOR_TEST);
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    });
+    ResourceManager::ReportLiveTextures();
+    ResourceManager::ReportTextureMemory();
+    TextureCache::Report();
 
-    // Variables para controlar el tiempo entre frames
+    // Variables para controlar el tiempo entre frames; la simulación avanza en ticks fijos
     float deltaTime = 0.0f;
-    float lastFrame = 0.0f;
+    float lastFrame = glfwGetTime(); // sin contar el tiempo de carga
+    bool firstFrame = true;
+    FixedTimestep timestep(SIMULATION_RATE, MAX_CATCH_UP_TICKS);
 
     // Bucle principal del juego
     while (!glfwWindowShouldClose(window))
@@ -72,23 +97,33 @@ int main(int argc, char *argv[])
         // Procesa eventos
         glfwPollEvents();
 
-        // Procesa la entrada del jugador
-        Breakout.ProcessInput(deltaTime);
-
-        // Actualiza el estado del juego
-        Breakout.Update(deltaTime);
+        // Procesa la entrada y actualiza el estado del juego una vez por tick, siempre con el mismo dt
+        unsigned int ticks = timestep.Advance(deltaTime);
+        for (unsigned int i = 0; i < ticks; ++i)
+        {
+            Breakout.BeginTick();
+            Breakout.ProcessInput(timestep.Step);
+            Breakout.Update(timestep.Step);
+        }
 
-        // Renderiza la escena
+        // Renderiza la escena entre el tick anterior y el actual
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
-        Breakout.Render();
+        Breakout.Render(timestep.Alpha());
 
         // Intercambia los buffers de la ventana
         glfwSwapBuffers(window);
+        if (firstFrame)
+        {
+            std::cout << "Time to first frame: " << (glfwGetTime() - startTime) * 1000.0 << " ms" << std::endl;
+            firstFrame = false;
+        }
     }
 
-    // Limpia los recursos utilizados
+    // Limpia los recursos utilizados y comprueba que no queden texturas GL vivas del ResourceManager
+    ResourceManager::ReportLiveTextures();
     ResourceManager::Clear();
+    ResourceManager::ReportLiveTextures();
 
     // Termina GLFW
     glfwTerminate();
@@ -0,0 +1,116 @@
+#include "program_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "asset_pack.h"
+
+std::string ProgramCache::Directory = "cache/";
+
+// FNV-1a de 64 bits encadenado
+static std::uint64_t hashBytes(std::uint64_t hash, const char *data)
+{
+    if (!data)
+        return hash;
+    for (; *data; ++data)
+    {
+        hash ^= static_cast<unsigned char>(*data);
+        hash *= 1099511628211ull;
+    }
+    // separador: "ab" + "c" no debe dar lo mismo que "a" + "bc"
+    hash ^= 0xff;
+    return hash * 1099511628211ull;
+}
+
+bool ProgramCache::Supported()
+{
+    static int supported = -1; // se consulta una vez por ejecución
+    if (supported < 0)
+    {
+        int formats = 0;
+        if (glad_glGetProgramBinary && glad_glProgramBinary && glad_glProgramParameteri)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = !Directory.empty() && formats > 0;
+    }
+    return supported == 1;
+}
+
+std::uint64_t ProgramCache::Key(const char *vertexSource, const char *fragmentSource, const char *geometrySource)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    hash = hashBytes(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = hashBytes(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = hashBytes(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    hash = hashBytes(hash, vertexSource);
+    hash = hashBytes(hash, fragmentSource);
+    return hashBytes(hash, geometrySource);
+}
+
+unsigned int ProgramCache::Load(std::uint64_t key)
+{
+    MappedFile file;
+    if (!file.Open(cacheFile(key).c_str()))
+        return 0;
+    const ProgramCacheHeader *header = reinterpret_cast<const ProgramCacheHeader*>(file.Data());
+    if (file.Size() < sizeof(ProgramCacheHeader) || std::memcmp(header->Magic, PROGRAM_CACHE_MAGIC, 4) != 0
+        || header->Version != PROGRAM_CACHE_VERSION || header->Key != key
+        || file.Size() < sizeof(ProgramCacheHeader) + header->Length)
+        return 0;
+    unsigned int program = glCreateProgram();
+    glProgramBinary(program, header->Format, file.Data() + sizeof(ProgramCacheHeader), header->Length);
+    // el driver puede rechazar binarios de otra versión aunque la cadena no haya cambiado
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void ProgramCache::Store(std::uint64_t key, unsigned int program)
+{
+    int length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    ProgramCacheHeader header;
+    std::memcpy(header.Magic, PROGRAM_CACHE_MAGIC, sizeof(header.Magic));
+    header.Version = PROGRAM_CACHE_VERSION;
+    header.Format = format;
+    header.Length = static_cast<std::uint32_t>(length);
+    header.Key = key;
+
+    std::error_code error;
+    std::filesystem::create_directories(Directory, error);
+    std::string path = cacheFile(key), temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), length);
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+}
+
+// cache/<clave>.prog
+std::string ProgramCache::cacheFile(std::uint64_t key)
+{
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return Directory + hex + ".prog";
+}
@@ -0,0 +1,39 @@
+#ifndef PROGRAM_CACHE_H
+#define PROGRAM_CACHE_H
+#include <cstdint>
+#include <string>
+
+// Formato de cada archivo (uno por programa): ProgramCacheHeader | binario del driver
+const char          PROGRAM_CACHE_MAGIC[4] = { 'S', 'A', 'P', 'B' };
+const std::uint32_t PROGRAM_CACHE_VERSION = 1;
+
+struct ProgramCacheHeader {
+    char          Magic[4];
+    std::uint32_t Version;
+    std::uint32_t Format;  // binaryFormat devuelto por glGetProgramBinary
+    std::uint32_t Length;
+    std::uint64_t Key;
+};
+
+// Caché en disco de programas enlazados (glGetProgramBinary / glProgramBinary).
+// La clave mezcla el código fuente con el fabricante, renderer y versión del driver,
+// así que un cambio en los shaders o en el driver vuelve a compilar desde el código.
+// Solo se usa si el contexto expone algún formato binario (GL 4.1 o ARB_get_program_binary).
+class ProgramCache
+{
+public:
+
+    static std::string Directory; // "" desactiva la caché
+    static bool          Supported();
+    static std::uint64_t Key(const char *vertexSource, const char *fragmentSource, const char *geometrySource);
+    // programa creado a partir del binario guardado; 0 si no hay entrada o el driver la rechaza
+    static unsigned int  Load(std::uint64_t key);
+    static void          Store(std::uint64_t key, unsigned int program);
+
+private:
+
+    ProgramCache() { }
+    static std::string cacheFile(std::uint64_t key);
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "projectile_pool.h"
+
+#include <iostream>
+
+ProjectilePool::ProjectilePool(unsigned int capacity)
+    : PositionX(capacity), PositionY(capacity), PreviousX(capacity), PreviousY(capacity),
+      VelocityX(capacity), VelocityY(capacity), Alive(capacity), Stats(),
+      count(0), highWater(0), end(0), totalRejected(0)
+{
+    this->freeList.reserve(capacity);
+    this->Clear();
+}
+
+int ProjectilePool::Spawn(glm::vec2 position, glm::vec2 velocity)
+{
+    if (this->freeList.empty())
+    {
+        ++this->Stats.Rejected;
+        ++this->totalRejected;
+        return -1;
+    }
+    unsigned int index = this->freeList.back();
+    this->freeList.pop_back();
+    this->PositionX[index] = this->PreviousX[index] = position.x;
+    this->PositionY[index] = this->PreviousY[index] = position.y;
+    this->VelocityX[index] = velocity.x;
+    this->VelocityY[index] = velocity.y;
+    this->Alive[index] = 1;
+    ++this->count;
+    ++this->Stats.Spawned;
+    if (this->count > this->highWater)
+        this->highWater = this->count;
+    if (index >= this->end)
+        this->end = index + 1;
+    return static_cast<int>(index);
+}
+
+void ProjectilePool::Despawn(unsigned int index)
+{
+    if (!this->Alive[index])
+        return;
+    this->Alive[index] = 0;
+    this->freeList.push_back(index);
+    --this->count;
+    ++this->Stats.Despawned;
+}
+
+void ProjectilePool::Clear()
+{
+    // la pila se rellena al revés para que la cima sea la plaza 0
+    unsigned int capacity = this->Capacity();
+    this->freeList.clear();
+    for (unsigned int i = capacity; i > 0; --i)
+        this->freeList.push_back(i - 1);
+    for (unsigned int i = 0; i < this->end; ++i)
+        this->Alive[i] = 0;
+    this->count = this->highWater = this->end = this->totalRejected = 0;
+}
+
+void ProjectilePool::ResetStats()
+{
+    this->Stats = ProjectileStats();
+}
+
+void ProjectilePool::Update(float dt, glm::vec2 min, glm::vec2 max)
+{
+    // las plazas libres también se mueven: sin ramas en el bucle (el compilador lo vectoriza), y
+    // su contenido no se usa
+    float *x = this->PositionX.data(), *y = this->PositionY.data();
+    float *previousX = this->PreviousX.data(), *previousY = this->PreviousY.data();
+    const float *vx = this->VelocityX.data(), *vy = this->VelocityY.data();
+    for (unsigned int i = 0; i < this->end; ++i)
+    {
+        previousX[i] = x[i];
+        previousY[i] = y[i];
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+    for (unsigned int i = 0; i < this->end; ++i)
+        if ((x[i] < min.x) | (x[i] > max.x) | (y[i] < min.y) | (y[i] > max.y))
+            this->Despawn(i); // no hace nada si la plaza ya estaba libre
+    // si las plazas altas se han vaciado, el recorrido se acorta
+    while (this->end > 0 && !this->Alive[this->end - 1])
+        --this->end;
+}
+
+void ProjectilePool::Report() const
+{
+    std::cout << "PROJECTILES: " << this->count << " live, high-water " << this->highWater << " of "
+              << this->Capacity() << " slots, " << this->totalRejected << " rejected" << std::endl;
+}
+
+glm::vec2 ProjectilePool::InterpolatedPosition(unsigned int index, float alpha) const
+{
+    return glm::mix(glm::vec2(this->PreviousX[index], this->PreviousY[index]), this->Position(index), alpha);
+}
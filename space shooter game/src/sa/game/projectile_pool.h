@@ -0,0 +1,53 @@
+#ifndef PROJECTILE_POOL_H
+#define PROJECTILE_POOL_H
+#include <vector>
+#include <glm/glm.hpp>
+
+// Contadores de Spawn/Despawn; se reinician con ResetStats() al inicio de cada tick
+struct ProjectileStats {
+    unsigned int Spawned   = 0;
+    unsigned int Despawned = 0;
+    unsigned int Rejected  = 0; // disparos perdidos con el pool lleno
+};
+
+// Proyectiles en estructura de arrays de capacidad fija, reservada una sola vez. Las plazas libres
+// forman una pila (lista libre), así Spawn y Despawn son O(1) y el índice de un proyectil no cambia
+// mientras vive. La pila empieza en la plaza 0 y reutiliza primero la última liberada, así las
+// ocupadas se agrupan al principio y Update solo recorre [0, End()). No usa GL.
+class ProjectilePool
+{
+public:
+
+    std::vector<float> PositionX, PositionY;          // centro
+    std::vector<float> PreviousX, PreviousY;          // centro en el tick anterior, para interpolar
+    std::vector<float> VelocityX, VelocityY;
+    std::vector<unsigned char> Alive;                 // 1 si la plaza está ocupada
+    ProjectileStats Stats;
+
+    ProjectilePool(unsigned int capacity);
+    unsigned int Count() const { return this->count; }
+    unsigned int Capacity() const { return static_cast<unsigned int>(this->Alive.size()); }
+    // máximo de proyectiles vivos a la vez desde el inicio (o el último Clear)
+    unsigned int HighWater() const { return this->highWater; }
+    // una plaza más allá de la más alta ocupada alguna vez; las vivas están en [0, End())
+    unsigned int End() const { return this->end; }
+    // índice del proyectil nuevo, o -1 si el pool está lleno
+    int  Spawn(glm::vec2 position, glm::vec2 velocity);
+    void Despawn(unsigned int index);
+    void Clear();
+    void ResetStats();
+    // ocupación actual, máximo alcanzado y disparos rechazados desde el último Clear
+    void Report() const;
+    // guarda la posición anterior y mueve todos en una pasada; los que salen de [min, max] se liberan
+    void Update(float dt, glm::vec2 min, glm::vec2 max);
+    glm::vec2 Position(unsigned int index) const { return glm::vec2(this->PositionX[index], this->PositionY[index]); }
+    glm::vec2 InterpolatedPosition(unsigned int index, float alpha) const;
+
+private:
+
+    std::vector<unsigned int> freeList; // plazas libres; la cima es la próxima en usarse
+    unsigned int count, highWater, end;
+    unsigned int totalRejected;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef RESOURCE_ID_H
+#define RESOURCE_ID_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Identificador de recurso: hash FNV-1a de 64 bits del nombre, calculable en tiempo de compilación.
+// "background"_rid produce el mismo valor que ResourceID("background") en tiempo de ejecución.
+struct ResourceID {
+    std::uint64_t Hash;
+
+    constexpr explicit ResourceID(const char *name) : Hash(hash(name, 14695981039346656037ull)) { }
+    constexpr bool operator==(const ResourceID &other) const { return this->Hash == other.Hash; }
+
+private:
+    static constexpr std::uint64_t hash(const char *name, std::uint64_t value)
+    {
+        return *name ? hash(name + 1, (value ^ static_cast<unsigned char>(*name)) * 1099511628211ull) : value;
+    }
+};
+
+constexpr ResourceID operator"" _rid(const char *name, std::size_t)
+{
+    return ResourceID(name);
+}
+
+// Tabla plana de direccionamiento abierto (sondeo lineal) indexada por ResourceID.
+// Las búsquedas no reservan memoria ni recorren árboles; solo crece al insertar.
+template <typename T>
+class ResourceTable
+{
+public:
+
+    ResourceTable() : count(0) { }
+
+    void Set(ResourceID id, const T &value)
+    {
+        if ((this->count + 1) * 10 > this->slots.size() * 7) // carga máxima del 70%
+            this->grow();
+        Slot &slot = this->probe(id.Hash);
+        if (!slot.Used)
+        {
+            slot.Used = true;
+            slot.Key = id.Hash;
+            ++this->count;
+        }
+        slot.Value = value;
+    }
+
+    const T *Find(ResourceID id) const
+    {
+        if (this->slots.empty())
+            return nullptr;
+        std::size_t mask = this->slots.size() - 1;
+        for (std::size_t i = id.Hash & mask; ; i = (i + 1) & mask)
+        {
+            const Slot &slot = this->slots[i];
+            if (!slot.Used)
+                return nullptr;
+            if (slot.Key == id.Hash)
+                return &slot.Value;
+        }
+    }
+
+    void Clear()
+    {
+        this->slots.clear();
+        this->count = 0;
+    }
+
+private:
+
+    struct Slot {
+        std::uint64_t Key = 0;
+        bool          Used = false;
+        T             Value;
+    };
+    std::vector<Slot> slots; // tamaño potencia de dos
+    std::size_t count;
+
+    Slot &probe(std::uint64_t key)
+    {
+        std::size_t mask = this->slots.size() - 1;
+        std::size_t i = key & mask;
+        while (this->slots[i].Used && this->slots[i].Key != key)
+            i = (i + 1) & mask;
+        return this->slots[i];
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old;
+        old.swap(this->slots);
+        this->slots.resize(old.empty() ? 16 : old.size() * 2);
+        this->count = 0;
+        for (Slot &slot : old)
+        {
+            if (!slot.Used)
+                continue;
+            Slot &target = this->probe(slot.Key);
+            target = slot;
+            ++this->count;
+        }
+    }
+};
+
+#endif
@@ -1,31 +1,147 @@
 #include "resource_manager.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include <fstream>
+#include "asset_pack.h"
 #include "stb_image.h"
+#include "texture_atlas.h"
+#include "texture_cache.h"
 
 // Inicializa los mapas estáticos para almacenar los shaders y texturas
 std::map<std::string, Texture2D> ResourceManager::Textures;
 std::map<std::string, Shader> ResourceManager::Shaders;
+std::vector<Texture2D> ResourceManager::AtlasPages;
+ResourceTable<Shader> ResourceManager::shaderTable;
+ResourceTable<Texture2D> ResourceManager::textureTable;
+std::vector<ResourceManager::PendingAtlasImage> ResourceManager::pendingAtlas;
+std::map<unsigned int, ResourceManager::TextureRecord> ResourceManager::textureRecords;
+std::map<std::string, unsigned int> ResourceManager::texturesByKey;
+std::size_t ResourceManager::DedupSavedBytes = 0;
+std::size_t ResourceManager::uploadedBytes = 0;
 
 // Carga un shader desde archivos y lo almacena en el mapa Shaders
 Shader ResourceManager::LoadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name)
 {
-    Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile); // Carga el shader y lo almacena con el nombre dado
+    Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile, name.c_str()); // Carga el shader y lo almacena con el nombre dado
+    shaderTable.Set(ResourceID(name.c_str()), Shaders[name]);
     return Shaders[name];
 }
 
+// Compila un shader a partir de código ya leído y lo almacena en el mapa Shaders
+Shader ResourceManager::LoadShaderFromSource(const char *vShaderCode, const char *fShaderCode, const char *gShaderCode, std::string name)
+{
+    Shader shader;
+    shader.Compile(vShaderCode, fShaderCode, gShaderCode, name.c_str());
+    Shaders[name] = shader;
+    shaderTable.Set(ResourceID(name.c_str()), shader);
+    return shader;
+}
+
+// Compila un programa de transform feedback (sin shader de fragmentos) y lo almacena en el mapa Shaders
+Shader ResourceManager::LoadFeedbackShader(const char *vShaderFile, const std::vector<const char*> &varyings, std::string name)
+{
+    std::string vertexCode = AssetPack::LoadText(vShaderFile);
+    if (vertexCode.empty())
+        std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
+    Shader shader;
+    shader.CompileFeedback(vertexCode.c_str(), varyings, name.c_str());
+    Shaders[name] = shader;
+    shaderTable.Set(ResourceID(name.c_str()), shader);
+    return shader;
+}
+
 // Obtiene un shader del mapa Shaders usando su nombre
 Shader ResourceManager::GetShader(std::string name)
 {
     return Shaders[name];
 }
 
+// Obtiene un shader por su identificador precalculado; vacío si no existe
+Shader ResourceManager::GetShader(ResourceID id)
+{
+    const Shader *shader = shaderTable.Find(id);
+    return shader ? *shader : Shader();
+}
+
 // Carga una textura desde un archivo y la almacena en el mapa Textures
-Texture2D ResourceManager::LoadTexture(const char *file, bool alpha, std::string name)
+Texture2D ResourceManager::LoadTexture(const char *file, bool alpha, std::string name, bool mipmaps)
 {
-    Textures[name] = loadTextureFromFile(file, alpha); // Carga la textura y la almacena con el nombre dado
-    return Textures[name];
+    // Si el mismo archivo ya está cargado con ese formato, solo se comparte: ni se lee ni se decodifica
+    std::string key = loadedKey(file, alpha);
+    if (!key.empty() && ShareTexture(key, name))
+        return Textures[name];
+    // Píxeles de la caché mapeada o, si está caducada, de stb_image
+    CachedImage image;
+    TextureCache::Decode(file, alpha, 0, mipmaps, image);
+    // Si otro archivo con el mismo contenido ya está cargado, también se comparte
+    return LoadTextureFromMemory(image.Data, image.Width, image.Height, alpha, name, image.Key, image.Levels, image.Channels); // Carga la textura y la almacena con el nombre dado
+}
+
+// Sube píxeles ya decodificados y los almacena en el mapa Textures
+Texture2D ResourceManager::LoadTextureFromMemory(const unsigned char *data, int width, int height, bool alpha, std::string name, const std::string &key, unsigned int levels, int channels)
+{
+    if (!key.empty() && ShareTexture(key, name))
+        return Textures[name];
+    Texture2D texture = uploadTexture(data, width, height, alpha, levels, channels ? channels : (alpha ? 4 : 3));
+    std::size_t bytes = static_cast<std::size_t>(width) * height * (alpha ? 4 : 3);
+    if (levels > 1)
+        bytes = bytes * 4 / 3; // la cadena de mips suma un tercio
+    textureRecords[texture.ID] = { texture, key, 0, bytes };
+    if (!key.empty())
+        texturesByKey[key] = texture.ID;
+    uploadedBytes += bytes;
+    bindTexture(name, texture);
+    return texture;
+}
+
+// Hace que name comparta la textura ya subida con la misma clave
+bool ResourceManager::ShareTexture(const std::string &key, std::string name)
+{
+    auto it = texturesByKey.find(key);
+    if (it == texturesByKey.end())
+        return false;
+    TextureRecord &record = textureRecords[it->second];
+    DedupSavedBytes += record.Bytes;
+    bindTexture(name, record.Texture);
+    return true;
+}
+
+// Clave de la textura subida desde file con ese formato (TextureKey es "file#hash:formato"); vacía si
+// no hay ninguna. Dentro de una ejecución se da por hecho que el archivo no cambia
+std::string ResourceManager::loadedKey(const char *file, bool alpha)
+{
+    std::string prefix = std::string(file) + "#";
+    std::string suffix = alpha ? ":rgba" : ":rgb";
+    for (auto it = texturesByKey.lower_bound(prefix); it != texturesByKey.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+        if (it->first.size() >= suffix.size() && it->first.compare(it->first.size() - suffix.size(), suffix.size(), suffix) == 0)
+            return it->first;
+    return std::string();
+}
+
+std::string ResourceManager::TextureKey(const char *file, const unsigned char *bytes, std::size_t size, bool alpha)
+{
+    // FNV-1a de 64 bits sobre los bytes del archivo
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(file) + "#" + hex + (alpha ? ":rgba" : ":rgb");
+}
+
+// Resumen de memoria de texturas: lo subido a GL y lo ahorrado por deduplicación
+void ResourceManager::ReportTextureMemory()
+{
+    std::cout << "TEXTURE MEMORY: " << textureRecords.size() << " textures + " << AtlasPages.size() << " atlas page(s), "
+              << uploadedBytes / 1024 << " KiB uploaded, " << DedupSavedBytes / 1024 << " KiB saved by deduplication" << std::endl;
 }
 
 // Obtiene una textura del mapa Textures usando su nombre
@@ -34,74 +150,269 @@ Texture2D ResourceManager::GetTexture(std::string name)
     return Textures[name];
 }
 
+// Obtiene una textura por su identificador precalculado; vacía si no existe
+Texture2D ResourceManager::GetTexture(ResourceID id)
+{
+    const Texture2D *texture = textureTable.Find(id);
+    return texture ? *texture : Texture2D();
+}
+
+// Reasigna un nombre lógico a una textura ya cargada (copia del handle, sin GL)
+void ResourceManager::AliasTexture(std::string name, std::string target)
+{
+    auto it = Textures.find(target);
+    if (it == Textures.end())
+    {
+        std::cout << "ERROR::TEXTURE: Cannot alias " << name << " to unknown texture " << target << std::endl;
+        return;
+    }
+    bindTexture(name, it->second);
+}
+
+// Recorre los nombres GL y cuenta cuáles siguen siendo texturas; un total que crece entre frames indica una fuga
+unsigned int ResourceManager::ReportLiveTextures()
+{
+    // Los drivers reparten nombres crecientes: uno recién generado sirve de cota superior
+    unsigned int bound = 0;
+    glGenTextures(1, &bound);
+    glDeleteTextures(1, &bound);
+    std::set<unsigned int> owned;
+    for (auto iter : Textures)
+        if (iter.second.ID != 0)
+            owned.insert(iter.second.ID);
+    for (const Texture2D &page : AtlasPages)
+        owned.insert(page.ID);
+    unsigned int live = 0, unowned = 0;
+    for (unsigned int id = 1; id < bound; ++id)
+    {
+        if (glIsTexture(id))
+        {
+            ++live;
+            if (owned.find(id) == owned.end())
+                ++unowned;
+        }
+    }
+    std::cout << "TEXTURES: " << live << " live GL names, " << owned.size() << " owned by ResourceManager, "
+              << unowned << " owned elsewhere" << std::endl;
+    return live;
+}
+
+// Decodifica una imagen en RGBA y la guarda para empaquetarla en BuildAtlas
+void ResourceManager::QueueAtlasTexture(const char *file, std::string name)
+{
+    CachedImage image;
+    if (!TextureCache::Decode(file, true, 4, false, image))
+    {
+        std::cout << "ERROR::TEXTURE: Failed to load " << file << std::endl;
+        return;
+    }
+    // Mismo contenido ya pendiente: solo se añade el nombre, sin copiar los píxeles
+    for (PendingAtlasImage &pending : pendingAtlas)
+    {
+        if (pending.Key == image.Key)
+        {
+            QueueAtlasImage(name, pending.Width, pending.Height, nullptr, image.Key);
+            return;
+        }
+    }
+    QueueAtlasImage(name, image.Width, image.Height, image.Release(), image.Key);
+}
+
+// Deja pendiente una imagen RGBA ya decodificada; BuildAtlas la libera con stbi_image_free
+void ResourceManager::QueueAtlasImage(std::string name, int width, int height, unsigned char *data, const std::string &key)
+{
+    if (!key.empty())
+    {
+        for (PendingAtlasImage &image : pendingAtlas)
+        {
+            if (image.Key == key)
+            {
+                image.Aliases.push_back(name);
+                DedupSavedBytes += static_cast<std::size_t>(image.Width) * image.Height * 4;
+                if (data)
+                    stbi_image_free(data);
+                return;
+            }
+        }
+    }
+    if (!data)
+    {
+        std::cout << "ERROR::TEXTURE: No image data for " << name << std::endl;
+        return;
+    }
+    pendingAtlas.push_back({ name, width, height, data, key, {} });
+}
+
+// Empaqueta las imágenes pendientes en una o varias páginas RGBA con un skyline
+void ResourceManager::BuildAtlas(unsigned int pageSize, unsigned int padding)
+{
+    struct Placement {
+        std::string  Name;
+        unsigned int Page, X, Y, Width, Height;
+    };
+    int maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize > 0)
+        pageSize = std::min(pageSize, static_cast<unsigned int>(maxTextureSize));
+
+    // Las imágenes más altas primero: el skyline deja menos huecos
+    std::stable_sort(pendingAtlas.begin(), pendingAtlas.end(),
+        [](const PendingAtlasImage &a, const PendingAtlasImage &b) { return a.Height > b.Height; });
+
+    std::vector<AtlasPacker> packers;
+    std::vector<std::vector<unsigned char>> pixels;
+    std::vector<Placement> placements;
+    for (PendingAtlasImage &image : pendingAtlas)
+    {
+        unsigned int width = image.Width, height = image.Height;
+        unsigned int paddedWidth = width + 2 * padding, paddedHeight = height + 2 * padding;
+        // Demasiado grande para una página: se sube como textura independiente
+        if (paddedWidth > pageSize || paddedHeight > pageSize)
+        {
+            LoadTextureFromMemory(image.Data, width, height, true, image.Name, image.Key);
+            for (const std::string &alias : image.Aliases)
+                LoadTextureFromMemory(image.Data, width, height, true, alias, image.Key);
+            continue;
+        }
+        unsigned int page = 0, x = 0, y = 0;
+        while (page < packers.size() && !packers[page].Pack(paddedWidth, paddedHeight, x, y))
+            ++page;
+        if (page == packers.size())
+        {
+            packers.push_back(AtlasPacker(pageSize, pageSize));
+            pixels.push_back(std::vector<unsigned char>(pageSize * pageSize * 4, 0));
+            packers[page].Pack(paddedWidth, paddedHeight, x, y);
+        }
+        // Copia la imagen repitiendo los bordes en el margen para que el filtrado lineal no mezcle vecinos
+        unsigned char *destination = pixels[page].data();
+        for (unsigned int row = 0; row < paddedHeight; ++row)
+        {
+            unsigned int sourceRow = std::min(row > padding ? row - padding : 0, height - 1);
+            for (unsigned int column = 0; column < paddedWidth; ++column)
+            {
+                unsigned int sourceColumn = std::min(column > padding ? column - padding : 0, width - 1);
+                std::memcpy(destination + ((y + row) * pageSize + x + column) * 4,
+                            image.Data + (sourceRow * width + sourceColumn) * 4, 4);
+            }
+        }
+        placements.push_back({ image.Name, static_cast<unsigned int>(AtlasPages.size()) + page, x + padding, y + padding, width, height });
+        for (const std::string &alias : image.Aliases)
+            placements.push_back({ alias, static_cast<unsigned int>(AtlasPages.size()) + page, x + padding, y + padding, width, height });
+    }
+
+    // Sube cada página una sola vez
+    for (std::vector<unsigned char> &data : pixels)
+    {
+        Texture2D page;
+        page.Internal_Format = GL_RGBA;
+        page.Image_Format = GL_RGBA;
+        page.Wrap_S = GL_CLAMP_TO_EDGE;
+        page.Wrap_T = GL_CLAMP_TO_EDGE;
+        page.Generate(pageSize, pageSize, data.data());
+        AtlasPages.push_back(page);
+        uploadedBytes += data.size();
+    }
+    // Registra un handle por nombre: textura de la página con su rectángulo UV
+    float size = static_cast<float>(pageSize);
+    for (const Placement &placement : placements)
+    {
+        Texture2D texture = AtlasPages[placement.Page];
+        texture.Width = placement.Width;
+        texture.Height = placement.Height;
+        texture.UV = glm::vec4(placement.X / size, placement.Y / size,
+                               (placement.X + placement.Width) / size, (placement.Y + placement.Height) / size);
+        bindTexture(placement.Name, texture);
+    }
+
+    for (PendingAtlasImage &image : pendingAtlas)
+        stbi_image_free(image.Data);
+    pendingAtlas.clear();
+    std::cout << "ATLAS: " << placements.size() << " textures packed into " << pixels.size() << " page(s) of " << pageSize << "x" << pageSize << std::endl;
+}
+
 // Limpia todos los shaders y texturas cargados
 void ResourceManager::Clear()
 {
     // Elimina todos los programas de shaders
     for (auto iter : Shaders)
         glDeleteProgram(iter.second.ID);
-    // Elimina todas las texturas
+    // Elimina todas las texturas; las entradas de atlas comparten la textura de su página
+    std::set<unsigned int> textureIDs;
     for (auto iter : Textures)
-        glDeleteTextures(1, &iter.second.ID);
+        textureIDs.insert(iter.second.ID);
+    for (const Texture2D &page : AtlasPages)
+        textureIDs.insert(page.ID);
+    for (unsigned int id : textureIDs)
+        glDeleteTextures(1, &id);
+    Textures.clear();
+    AtlasPages.clear();
+    textureRecords.clear();
+    texturesByKey.clear();
+    Shaders.clear();
+    shaderTable.Clear();
+    textureTable.Clear();
 }
 
 // Función auxiliar para cargar un shader desde archivos
-Shader ResourceManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile)
+Shader ResourceManager::loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, const char *name)
 {
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::string geometryCode;
-    try
-    {
-        // Abre los archivos de los shaders
-        std::ifstream vertexShaderFile(vShaderFile);
-        std::ifstream fragmentShaderFile(fShaderFile);
-        std::stringstream vShaderStream, fShaderStream;
-        // Lee el contenido de los archivos
-        vShaderStream << vertexShaderFile.rdbuf();
-        fShaderStream << fragmentShaderFile.rdbuf();
-        vertexShaderFile.close();
-        fragmentShaderFile.close();
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-        // Si hay un archivo de shader geométrico, también lo lee
-        if (gShaderFile != nullptr)
-        {
-            std::ifstream geometryShaderFile(gShaderFile);
-            std::stringstream gShaderStream;
-            gShaderStream << geometryShaderFile.rdbuf();
-            geometryShaderFile.close();
-            geometryCode = gShaderStream.str();
-        }
-    }
-    catch (std::exception e)
-    {
+    // Lee el código de los shaders, del paquete montado o del disco
+    std::string vertexCode = AssetPack::LoadText(vShaderFile);
+    std::string fragmentCode = AssetPack::LoadText(fShaderFile);
+    std::string geometryCode = gShaderFile != nullptr ? AssetPack::LoadText(gShaderFile) : std::string();
+    if (vertexCode.empty() || fragmentCode.empty())
         std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
-    }
     // Compila los shaders
     const char *vShaderCode = vertexCode.c_str();
     const char *fShaderCode = fragmentCode.c_str();
     const char *gShaderCode = geometryCode.c_str();
     Shader shader;
-    shader.Compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
+    shader.Compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr, name);
     return shader;
 }
 
-// Función auxiliar para cargar una textura desde un archivo
-Texture2D ResourceManager::loadTextureFromFile(const char *file, bool alpha)
+// Función auxiliar para crear la textura GL a partir de píxeles decodificados
+Texture2D ResourceManager::uploadTexture(const unsigned char *data, int width, int height, bool alpha, unsigned int levels, int channels)
 {
     Texture2D texture;
-    // Configura el formato de la textura
+    // Configura el formato de la textura: alpha decide cómo se guarda en GL y channels cómo
+    // vienen los píxeles (un PNG RGBA cargado sin alpha sigue trayendo 4 canales)
     if (alpha)
-    {
         texture.Internal_Format = GL_RGBA;
-        texture.Image_Format = GL_RGBA;
-    }
-    // Carga la imagen usando stb_image
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 0);
-    // Genera la textura
-    texture.Generate(width, height, data);
-    stbi_image_free(data); // Libera la memoria de la imagen
+    texture.Image_Format = channels == 4 ? GL_RGBA : channels == 2 ? GL_RG : channels == 1 ? GL_RED : GL_RGB;
+    if (levels > 1)
+        texture.Filter_Min = GL_LINEAR_MIPMAP_LINEAR;
+    texture.Generate(width, height, data, levels, static_cast<unsigned int>(channels));
     return texture;
 }
+
+// Asocia name a una textura: suma una referencia a la nueva y suelta la anterior
+void ResourceManager::bindTexture(const std::string &name, const Texture2D &texture)
+{
+    auto record = textureRecords.find(texture.ID);
+    if (record != textureRecords.end())
+        ++record->second.RefCount;
+    releaseTexture(name);
+    Textures[name] = texture;
+    textureTable.Set(ResourceID(name.c_str()), texture);
+}
+
+// Suelta la referencia de name; la textura GL se borra cuando ningún nombre la usa.
+// Las páginas de atlas no llevan recuento y solo se liberan en Clear
+void ResourceManager::releaseTexture(const std::string &name)
+{
+    auto previous = Textures.find(name);
+    if (previous == Textures.end())
+        return;
+    auto record = textureRecords.find(previous->second.ID);
+    if (record == textureRecords.end())
+        return;
+    if (--record->second.RefCount > 0)
+        return;
+    unsigned int id = record->first;
+    if (!record->second.Key.empty())
+        texturesByKey.erase(record->second.Key);
+    uploadedBytes -= record->second.Bytes;
+    textureRecords.erase(record);
+    glDeleteTextures(1, &id);
+}
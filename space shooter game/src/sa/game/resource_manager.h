@@ -1,8 +1,11 @@
 #ifndef RESOURCE_MANAGER_H
 #define RESOURCE_MANAGER_H
+#include <cstddef>
 #include <map>
 #include <string>
+#include <vector>
 #include <glad/glad.h>
+#include "resource_id.h"
 #include "texture.h"
 #include "shader.h"
 
@@ -14,16 +17,70 @@ public:
 
     static std::map<std::string, Shader>    Shaders;
     static std::map<std::string, Texture2D> Textures;
+    static std::vector<Texture2D>           AtlasPages;
+    // bytes de textura que no se subieron a GL gracias a la deduplicación por contenido
+    static std::size_t                      DedupSavedBytes;
     static Shader    LoadShader(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile, std::string name);
     static Shader    GetShader(std::string name);
-    static Texture2D LoadTexture(const char *file, bool alpha, std::string name);
+    // búsqueda sin reservas de memoria para el bucle de juego: GetShader("sprite"_rid)
+    static Shader    GetShader(ResourceID id);
+    // variantes para el cargador asíncrono: el código o los píxeles ya se leyeron en otro hilo
+    static Shader    LoadShaderFromSource(const char *vShaderCode, const char *fShaderCode, const char *gShaderCode, std::string name);
+    // programa solo de vértices cuyas salidas varyings se capturan con transform feedback
+    static Shader    LoadFeedbackShader(const char *vShaderFile, const std::vector<const char*> &varyings, std::string name);
+    // channels: canales por píxel de data (0: 4 si alpha, 3 si no)
+    static Texture2D LoadTextureFromMemory(const unsigned char *data, int width, int height, bool alpha, std::string name, const std::string &key = "", unsigned int levels = 1, int channels = 0);
+    // los píxeles salen de TextureCache; mipmaps sube también la cadena de mips precalculada
+    static Texture2D LoadTexture(const char *file, bool alpha, std::string name, bool mipmaps = false);
     static Texture2D GetTexture(std::string name);
+    // búsqueda sin reservas de memoria para el bucle de juego: GetTexture("background"_rid)
+    static Texture2D GetTexture(ResourceID id);
+    // clave de deduplicación: ruta + hash FNV-1a del contenido del archivo + formato
+    static std::string TextureKey(const char *file, const unsigned char *bytes, std::size_t size, bool alpha);
+    // si ya hay una textura con esa clave, name pasa a compartirla (con recuento de referencias)
+    static bool      ShareTexture(const std::string &key, std::string name);
+    static void      ReportTextureMemory();
+    // hace que name apunte a una textura ya cargada, sin decodificar ni reservar nada en GL
+    static void      AliasTexture(std::string name, std::string target);
+    // cuenta los nombres de textura GL vivos y los que no pertenecen al ResourceManager
+    static unsigned int ReportLiveTextures();
+    // decodifica una imagen RGBA y la deja pendiente de empaquetar en el atlas
+    static void      QueueAtlasTexture(const char *file, std::string name);
+    // igual que QueueAtlasTexture con una imagen RGBA ya decodificada por stb_image (pasa a ser del ResourceManager)
+    // con una clave ya pendiente, name comparte esa imagen y data (si no es nula) se libera
+    static void      QueueAtlasImage(std::string name, int width, int height, unsigned char *data, const std::string &key = "");
+    // empaqueta las imágenes pendientes en páginas y registra sus handles (página + UV) en Textures
+    static void      BuildAtlas(unsigned int pageSize = 2048, unsigned int padding = 1);
     static void      Clear();
 private:
 
+    struct PendingAtlasImage {
+        std::string    Name;
+        int            Width, Height;
+        unsigned char *Data;
+        std::string    Key;
+        std::vector<std::string> Aliases; // otros nombres con el mismo contenido
+    };
+    // texturas GL propias (no páginas de atlas) con su recuento de nombres que las usan
+    struct TextureRecord {
+        Texture2D    Texture;
+        std::string  Key;
+        unsigned int RefCount;
+        std::size_t  Bytes;
+    };
+    // espejo de Shaders/Textures indexado por ResourceID; los mapas por nombre quedan para herramientas
+    static ResourceTable<Shader>    shaderTable;
+    static ResourceTable<Texture2D> textureTable;
+    static std::vector<PendingAtlasImage> pendingAtlas;
+    static std::map<unsigned int, TextureRecord> textureRecords;
+    static std::map<std::string, unsigned int>   texturesByKey;
+    static std::size_t                           uploadedBytes;
     ResourceManager() { }
-    static Shader    loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile = nullptr);
-    static Texture2D loadTextureFromFile(const char *file, bool alpha);
+    static Shader    loadShaderFromFile(const char *vShaderFile, const char *fShaderFile, const char *gShaderFile = nullptr, const char *name = nullptr);
+    static Texture2D uploadTexture(const unsigned char *data, int width, int height, bool alpha, unsigned int levels, int channels);
+    static std::string loadedKey(const char *file, bool alpha);
+    static void      bindTexture(const std::string &name, const Texture2D &texture);
+    static void      releaseTexture(const std::string &name);
 };
 
 #endif
\ No newline at end of file
@@ -1,14 +1,54 @@
 #include "shader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 
+#include "program_cache.h"
+
 Shader &Shader::Use()
 {
     glUseProgram(this->ID);
     return *this;
 }
 
-void Shader::Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource)
+void Shader::Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource, const char* name)
+{
+    this->compileProgram(vertexSource, fragmentSource, geometrySource, nullptr, name);
+}
+
+void Shader::CompileFeedback(const char* vertexSource, const std::vector<const char*> &varyings, const char* name)
+{
+    this->compileProgram(vertexSource, nullptr, nullptr, &varyings, name);
+}
+
+void Shader::compileProgram(const char* vertexSource, const char* fragmentSource, const char* geometrySource,
+                            const std::vector<const char*> *varyings, const char* name)
 {
+    typedef std::chrono::steady_clock clock;
+    auto milliseconds = [](clock::time_point from, clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    };
+    clock::time_point start = clock::now();
+    // program binary cache: skips both compile and link when the sources and driver are unchanged
+    std::uint64_t key = 0;
+    if (ProgramCache::Supported())
+    {
+        // the captured varyings are part of the linked program, so they go into the key
+        std::string feedback = "feedback:";
+        if (varyings)
+            for (const char *varying : *varyings)
+                feedback.append(varying).append(",");
+        key = ProgramCache::Key(vertexSource, fragmentSource ? fragmentSource : feedback.c_str(), geometrySource);
+        this->ID = ProgramCache::Load(key);
+        if (this->ID != 0)
+        {
+            this->reflectUniforms();
+            std::cout << "SHADER: " << (name ? name : "program") << " loaded from program cache in "
+                      << milliseconds(start, clock::now()) << " ms" << std::endl;
+            return;
+        }
+    }
     unsigned int sVertex, sFragment, gShader;
     // vertex Shader
     sVertex = glCreateShader(GL_VERTEX_SHADER);
@@ -16,10 +56,13 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
     glCompileShader(sVertex);
     checkCompileErrors(sVertex, "VERTEX");
     // fragment Shader
-    sFragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(sFragment, 1, &fragmentSource, NULL);
-    glCompileShader(sFragment);
-    checkCompileErrors(sFragment, "FRAGMENT");
+    if (fragmentSource != nullptr)
+    {
+        sFragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(sFragment, 1, &fragmentSource, NULL);
+        glCompileShader(sFragment);
+        checkCompileErrors(sFragment, "FRAGMENT");
+    }
     if (geometrySource != nullptr)
     {
         gShader = glCreateShader(GL_GEOMETRY_SHADER);
@@ -27,75 +70,162 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
         glCompileShader(gShader);
         checkCompileErrors(gShader, "GEOMETRY");
     }
+    clock::time_point compiled = clock::now();
     // shader program
     this->ID = glCreateProgram();
     glAttachShader(this->ID, sVertex);
-    glAttachShader(this->ID, sFragment);
+    if (fragmentSource != nullptr)
+        glAttachShader(this->ID, sFragment);
     if (geometrySource != nullptr)
         glAttachShader(this->ID, gShader);
+    if (varyings != nullptr)
+        glTransformFeedbackVaryings(this->ID, static_cast<int>(varyings->size()), varyings->data(), GL_INTERLEAVED_ATTRIBS);
+    if (key != 0)
+        glProgramParameteri(this->ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(this->ID);
     checkCompileErrors(this->ID, "PROGRAM");
+    clock::time_point linked = clock::now();
+    this->reflectUniforms();
     glDeleteShader(sVertex);
-    glDeleteShader(sFragment);
+    if (fragmentSource != nullptr)
+        glDeleteShader(sFragment);
     if (geometrySource != nullptr)
         glDeleteShader(gShader);
+    int success = 0;
+    glGetProgramiv(this->ID, GL_LINK_STATUS, &success);
+    if (key != 0 && success)
+        ProgramCache::Store(key, this->ID);
+    std::cout << "SHADER: " << (name ? name : "program") << " compiled in " << milliseconds(start, compiled)
+              << " ms, linked in " << milliseconds(compiled, linked) << " ms" << std::endl;
+}
+
+UniformLocation Shader::GetUniform(const char *name) const
+{
+    if (!this->uniforms)
+        return { -1 };
+    auto it = std::lower_bound(this->uniforms->begin(), this->uniforms->end(), name,
+        [](const UniformEntry &entry, const char *key) { return std::strcmp(entry.Name.c_str(), key) < 0; });
+    if (it == this->uniforms->end() || std::strcmp(it->Name.c_str(), name) != 0)
+        return { -1 };
+    return { it->Location };
 }
 
 void Shader::SetFloat(const char *name, float value, bool useShader)
+{
+    this->SetFloat(this->GetUniform(name), value, useShader);
+}
+void Shader::SetInteger(const char *name, int value, bool useShader)
+{
+    this->SetInteger(this->GetUniform(name), value, useShader);
+}
+void Shader::SetVector2f(const char *name, float x, float y, bool useShader)
+{
+    this->SetVector2f(this->GetUniform(name), x, y, useShader);
+}
+void Shader::SetVector2f(const char *name, const glm::vec2 &value, bool useShader)
+{
+    this->SetVector2f(this->GetUniform(name), value, useShader);
+}
+void Shader::SetVector3f(const char *name, float x, float y, float z, bool useShader)
+{
+    this->SetVector3f(this->GetUniform(name), x, y, z, useShader);
+}
+void Shader::SetVector3f(const char *name, const glm::vec3 &value, bool useShader)
+{
+    this->SetVector3f(this->GetUniform(name), value, useShader);
+}
+void Shader::SetVector4f(const char *name, float x, float y, float z, float w, bool useShader)
+{
+    this->SetVector4f(this->GetUniform(name), x, y, z, w, useShader);
+}
+void Shader::SetVector4f(const char *name, const glm::vec4 &value, bool useShader)
+{
+    this->SetVector4f(this->GetUniform(name), value, useShader);
+}
+void Shader::SetMatrix4(const char *name, const glm::mat4 &matrix, bool useShader)
+{
+    this->SetMatrix4(this->GetUniform(name), matrix, useShader);
+}
+void Shader::SetFloat(UniformLocation uniform, float value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform1f(glGetUniformLocation(this->ID, name), value);
+    glUniform1f(uniform.Location, value);
 }
-void Shader::SetInteger(const char *name, int value, bool useShader)
+void Shader::SetInteger(UniformLocation uniform, int value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform1i(glGetUniformLocation(this->ID, name), value);
+    glUniform1i(uniform.Location, value);
 }
-void Shader::SetVector2f(const char *name, float x, float y, bool useShader)
+void Shader::SetVector2f(UniformLocation uniform, float x, float y, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+    glUniform2f(uniform.Location, x, y);
 }
-void Shader::SetVector2f(const char *name, const glm::vec2 &value, bool useShader)
+void Shader::SetVector2f(UniformLocation uniform, const glm::vec2 &value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    glUniform2f(uniform.Location, value.x, value.y);
 }
-void Shader::SetVector3f(const char *name, float x, float y, float z, bool useShader)
+void Shader::SetVector3f(UniformLocation uniform, float x, float y, float z, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    glUniform3f(uniform.Location, x, y, z);
 }
-void Shader::SetVector3f(const char *name, const glm::vec3 &value, bool useShader)
+void Shader::SetVector3f(UniformLocation uniform, const glm::vec3 &value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    glUniform3f(uniform.Location, value.x, value.y, value.z);
 }
-void Shader::SetVector4f(const char *name, float x, float y, float z, float w, bool useShader)
+void Shader::SetVector4f(UniformLocation uniform, float x, float y, float z, float w, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    glUniform4f(uniform.Location, x, y, z, w);
 }
-void Shader::SetVector4f(const char *name, const glm::vec4 &value, bool useShader)
+void Shader::SetVector4f(UniformLocation uniform, const glm::vec4 &value, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+    glUniform4f(uniform.Location, value.x, value.y, value.z, value.w);
 }
-void Shader::SetMatrix4(const char *name, const glm::mat4 &matrix, bool useShader)
+void Shader::SetMatrix4(UniformLocation uniform, const glm::mat4 &matrix, bool useShader)
 {
     if (useShader)
         this->Use();
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+    glUniformMatrix4fv(uniform.Location, 1, false, glm::value_ptr(matrix));
 }
 
+void Shader::reflectUniforms()
+{
+    auto table = std::make_shared<std::vector<UniformEntry>>();
+    int count = 0, maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(std::max(maxLength, 1));
+    for (int i = 0; i < count; ++i)
+    {
+        int length = 0, size = 0;
+        unsigned int type;
+        glGetActiveUniform(this->ID, i, maxLength, &length, &size, &type, name.data());
+        int location = glGetUniformLocation(this->ID, name.data());
+        if (location < 0)
+            continue; // uniforms inside a uniform block have no location
+        std::string uniformName(name.data(), length);
+        table->push_back({ uniformName, location });
+        // arrays are reported as "name[0]"; register the bare name as well
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+            table->push_back({ uniformName.substr(0, uniformName.size() - 3), location });
+    }
+    std::sort(table->begin(), table->end(),
+        [](const UniformEntry &a, const UniformEntry &b) { return a.Name < b.Name; });
+    this->uniforms = table;
+}
 
 void Shader::checkCompileErrors(unsigned int object, std::string type)
 {
@@ -9,13 +9,21 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 
+// Pre-resolved uniform location; obtain once through Shader::GetUniform
+// and pass it to the typed setters in per-frame code.
+struct UniformLocation {
+    int Location;
+};
+
 // General purpsoe shader object. Compiles from file, generates
 // compile/link-time error messages and hosts several utility 
 // functions for easy management.
@@ -28,8 +36,14 @@ public:
     Shader() { }
     // sets the current shader as active
     Shader  &Use();
-    // compiles the shader from given source code
-    void    Compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr); // note: geometry source code is optional 
+    // compiles the shader from given source code, or loads the linked program from the
+    // program binary cache; name only labels the timing line printed to the console
+    void    Compile(const char *vertexSource, const char *fragmentSource, const char *geometrySource = nullptr, const char *name = nullptr); // note: geometry source code is optional 
+    // compiles a vertex-only program whose outputs are captured, interleaved and in the given
+    // order, with transform feedback (used with GL_RASTERIZER_DISCARD for GPU simulation)
+    void    CompileFeedback(const char *vertexSource, const std::vector<const char*> &varyings, const char *name = nullptr);
+    // looks up a uniform in the table reflected at link time (-1 if not active)
+    UniformLocation GetUniform(const char *name) const;
     // utility functions
     void    SetFloat    (const char *name, float value, bool useShader = false);
     void    SetInteger  (const char *name, int value, bool useShader = false);
@@ -40,9 +54,30 @@ public:
     void    SetVector4f (const char *name, float x, float y, float z, float w, bool useShader = false);
     void    SetVector4f (const char *name, const glm::vec4 &value, bool useShader = false);
     void    SetMatrix4  (const char *name, const glm::mat4 &matrix, bool useShader = false);
+    // same setters taking a location resolved beforehand with GetUniform
+    void    SetFloat    (UniformLocation uniform, float value, bool useShader = false);
+    void    SetInteger  (UniformLocation uniform, int value, bool useShader = false);
+    void    SetVector2f (UniformLocation uniform, float x, float y, bool useShader = false);
+    void    SetVector2f (UniformLocation uniform, const glm::vec2 &value, bool useShader = false);
+    void    SetVector3f (UniformLocation uniform, float x, float y, float z, bool useShader = false);
+    void    SetVector3f (UniformLocation uniform, const glm::vec3 &value, bool useShader = false);
+    void    SetVector4f (UniformLocation uniform, float x, float y, float z, float w, bool useShader = false);
+    void    SetVector4f (UniformLocation uniform, const glm::vec4 &value, bool useShader = false);
+    void    SetMatrix4  (UniformLocation uniform, const glm::mat4 &matrix, bool useShader = false);
 private:
+    struct UniformEntry {
+        std::string  Name;
+        int          Location;
+    };
+    // active uniforms sorted by name; shared between copies of the same program
+    std::shared_ptr<const std::vector<UniformEntry>> uniforms;
+    // shared by Compile and CompileFeedback; fragmentSource is null for feedback programs
+    void    compileProgram(const char *vertexSource, const char *fragmentSource, const char *geometrySource,
+                           const std::vector<const char*> *varyings, const char *name);
     // checks if compilation or linking failed and if so, print the error logs
     void    checkCompileErrors(unsigned int object, std::string type); 
+    // queries the active uniforms of the linked program into the location table
+    void    reflectUniforms();
 };
 
 #endif
\ No newline at end of file
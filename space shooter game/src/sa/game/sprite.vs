@@ -6,9 +6,11 @@ out vec2 TexCoords;
 uniform mat4 model;
 // note that we're omitting the view matrix; the view never changes so we basically have an identity view matrix and can therefore omit it.
 uniform mat4 projection;
+// sub-rectangle of the bound texture (u0, v0, u1, v1); (0, 0, 1, 1) for standalone textures
+uniform vec4 uvRect;
 
 void main()
 {
-    TexCoords = vertex.zw;
+    TexCoords = mix(uvRect.xy, uvRect.zw, vertex.zw);
     gl_Position = projection * model * vec4(vertex.xy, 0.0, 1.0);
 }
\ No newline at end of file
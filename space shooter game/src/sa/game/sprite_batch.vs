@@ -0,0 +1,26 @@
+#version 330 core
+layout (location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
+layout (location = 1) in vec2 instancePosition;
+layout (location = 2) in vec2 instanceSize;
+layout (location = 3) in float instanceRotation; // degrees
+layout (location = 4) in vec3 instanceColor;
+layout (location = 5) in vec4 instanceUV; // atlas sub-rectangle (u0, v0, u1, v1)
+
+out vec2 TexCoords;
+out vec3 SpriteColor;
+
+uniform mat4 projection;
+
+void main()
+{
+    // same transform as SpriteRenderer::DrawSprite: scale, rotate around the center, translate
+    vec2 halfSize = 0.5 * instanceSize;
+    vec2 local = vertex.xy * instanceSize - halfSize;
+    float angle = radians(instanceRotation);
+    float s = sin(angle);
+    float c = cos(angle);
+    vec2 rotated = vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+    TexCoords = mix(instanceUV.xy, instanceUV.zw, vertex.zw);
+    SpriteColor = instanceColor;
+    gl_Position = projection * vec4(rotated + halfSize + instancePosition, 0.0, 1.0);
+}
@@ -1,14 +1,43 @@
 #include "sprite_renderer.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
 SpriteRenderer::SpriteRenderer(Shader shader)
+    : Stats(), batchVAO(0), instanceVBO(0), instanceCapacity(0), batching(false),
+      frames(0), totalSprites(0), totalDrawCalls(0), totalSaved(0)
+{
+    this->shader = shader;
+    this->modelUniform = this->shader.GetUniform("model");
+    this->colorUniform = this->shader.GetUniform("spriteColor");
+    this->uvUniform = this->shader.GetUniform("uvRect");
+    this->batchShader.ID = 0;
+    this->initRenderData();
+}
+
+SpriteRenderer::SpriteRenderer(Shader shader, Shader batchShader)
+    : Stats(), batchVAO(0), instanceVBO(0), instanceCapacity(0), batching(false),
+      frames(0), totalSprites(0), totalDrawCalls(0), totalSaved(0)
 {
     this->shader = shader;
+    this->modelUniform = this->shader.GetUniform("model");
+    this->colorUniform = this->shader.GetUniform("spriteColor");
+    this->uvUniform = this->shader.GetUniform("uvRect");
+    this->batchShader = batchShader;
     this->initRenderData();
+    this->initBatchData();
 }
 
 SpriteRenderer::~SpriteRenderer()
 {
     glDeleteVertexArrays(1, &this->quadVAO);
+    glDeleteBuffers(1, &this->quadVBO);
+    if (this->batchVAO)
+    {
+        glDeleteVertexArrays(1, &this->batchVAO);
+        glDeleteBuffers(1, &this->instanceVBO);
+    }
 }
 
 void SpriteRenderer::DrawSprite(Texture2D texture, glm::vec2 position, glm::vec2 size, float rotate, glm::vec3 color)
@@ -23,9 +52,10 @@ void SpriteRenderer::DrawSprite(Texture2D texture, glm::vec2 position, glm::vec2
 
     model = glm::scale(model, glm::vec3(size, 1.0f)); 
 
-    this->shader.SetMatrix4("model", model);
+    this->shader.SetMatrix4(this->modelUniform, model);
 
-    this->shader.SetVector3f("spriteColor", color);
+    this->shader.SetVector3f(this->colorUniform, color);
+    this->shader.SetVector4f(this->uvUniform, texture.UV);
 
     glActiveTexture(GL_TEXTURE0);
     texture.Bind();
@@ -45,8 +75,9 @@ void SpriteRenderer::DrawSprites(Texture2D texture, glm::vec2 position, glm::vec
         {
             if (i < 10)
             {
-                this->shader.SetMatrix4("model", model);
-                this->shader.SetVector3f("spriteColor", color);
+                this->shader.SetMatrix4(this->modelUniform, model);
+                this->shader.SetVector3f(this->colorUniform, color);
+                this->shader.SetVector4f(this->uvUniform, texture.UV);
                 model = glm::translate(model, glm::vec3(position, 0.0f));
                 model = glm::translate(model, glm::vec3(.5f * size.x, 0.5f * size.y, 0.0f));
                 model = glm::rotate(model, glm::radians(rotate), glm::vec3(0.0f, 0.0f, 1.0f));
@@ -60,8 +91,9 @@ void SpriteRenderer::DrawSprites(Texture2D texture, glm::vec2 position, glm::vec
             }
             if (i > 10)
             {
-                this->shader.SetMatrix4("model", model);
-                this->shader.SetVector3f("spriteColor", color);
+                this->shader.SetMatrix4(this->modelUniform, model);
+                this->shader.SetVector3f(this->colorUniform, color);
+                this->shader.SetVector4f(this->uvUniform, texture.UV);
                 model = glm::translate(model, glm::vec3(position, 0.0f));
                 model = glm::translate(model, glm::vec3(.5f * size.x, 0.5f * size.y, 0.0f));
                 model = glm::rotate(model, glm::radians(rotate), glm::vec3(0.0f, 0.0f, 1.0f));
@@ -78,9 +110,112 @@ void SpriteRenderer::DrawSprites(Texture2D texture, glm::vec2 position, glm::vec
     }
 
 }
+
+void SpriteRenderer::Begin()
+{
+    this->instances.clear();
+    this->instanceTextures.clear();
+    // sin shader instanciado Submit dibuja directamente con DrawSprite
+    this->batching = this->batchVAO != 0;
+}
+
+void SpriteRenderer::Submit(Texture2D texture, glm::vec2 position, glm::vec2 size, float rotate, glm::vec3 color)
+{
+    if (!this->batching)
+    {
+        this->DrawSprite(texture, position, size, rotate, color);
+        this->Stats.Sprites++;
+        this->Stats.DrawCalls++;
+        return;
+    }
+    this->instances.push_back({ position, size, rotate, color, texture.UV });
+    this->instanceTextures.push_back(texture.ID);
+}
+
+void SpriteRenderer::Flush()
+{
+    this->batching = false;
+    unsigned int count = static_cast<unsigned int>(this->instances.size());
+    if (count == 0)
+        return;
+
+    // agrupa por textura (página de atlas) conservando el orden de envío dentro de cada grupo;
+    // los sprites que se solapan con texturas distintas deben ir en lotes separados
+    this->order.resize(count);
+    for (unsigned int i = 0; i < count; ++i)
+        this->order[i] = i;
+    std::stable_sort(this->order.begin(), this->order.end(), [this](unsigned int a, unsigned int b) {
+        return this->instanceTextures[a] < this->instanceTextures[b];
+    });
+    this->sorted.resize(count);
+    for (unsigned int i = 0; i < count; ++i)
+        this->sorted[i] = this->instances[this->order[i]];
+
+    // buffer de instancias en streaming: crece si hace falta y se huerfaniza en cada Flush
+    glBindBuffer(GL_ARRAY_BUFFER, this->instanceVBO);
+    if (count > this->instanceCapacity)
+        this->instanceCapacity = std::max(count, this->instanceCapacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, this->instanceCapacity * sizeof(SpriteInstance), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(SpriteInstance), this->sorted.data());
+
+    this->batchShader.Use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(this->batchVAO);
+    unsigned int groups = 0;
+    unsigned int first = 0;
+    while (first < count)
+    {
+        unsigned int textureID = this->instanceTextures[this->order[first]];
+        unsigned int last = first + 1;
+        while (last < count && this->instanceTextures[this->order[last]] == textureID)
+            ++last;
+        // GL 3.3 no tiene baseInstance, así que se desplazan los punteros de atributos al inicio del grupo
+        std::size_t base = first * sizeof(SpriteInstance);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, Position)));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, Size)));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, Rotation)));
+        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, Color)));
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, UV)));
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, last - first);
+        ++groups;
+        first = last;
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    this->Stats.Sprites += count;
+    this->Stats.DrawCalls += groups;
+    this->Stats.DrawCallsSaved += count - groups;
+    this->instances.clear();
+    this->instanceTextures.clear();
+}
+
+void SpriteRenderer::ResetStats()
+{
+    this->totalSprites += this->Stats.Sprites;
+    this->totalDrawCalls += this->Stats.DrawCalls;
+    this->totalSaved += this->Stats.DrawCallsSaved;
+    ++this->frames;
+    this->Stats = SpriteBatchStats();
+}
+
+void SpriteRenderer::Report()
+{
+    // el frame en curso aún no se ha sumado
+    unsigned long long sprites = this->totalSprites + this->Stats.Sprites;
+    unsigned long long drawCalls = this->totalDrawCalls + this->Stats.DrawCalls;
+    unsigned long long saved = this->totalSaved + this->Stats.DrawCallsSaved;
+    double perFrame = this->frames > 0 ? 1.0 / this->frames : 0.0;
+    std::cout << "SPRITE BATCH: " << sprites << " sprites in " << drawCalls << " draw calls over " << this->frames << " frames ("
+              << drawCalls * perFrame << " per frame), " << saved << " draw calls saved (" << saved * perFrame << " per frame)" << std::endl;
+    this->frames = 0;
+    this->totalSprites = this->totalDrawCalls = this->totalSaved = 0;
+    this->Stats = SpriteBatchStats();
+}
+
 void SpriteRenderer::initRenderData()
 {
-    unsigned int VBO;
     float vertices[] = { 
         0.0f, 1.0f, 0.0f, 1.0f,
         1.0f, 0.0f, 1.0f, 0.0f,
@@ -92,9 +227,9 @@ void SpriteRenderer::initRenderData()
     };
 
     glGenVertexArrays(1, &this->quadVAO);
-    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &this->quadVBO);
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, this->quadVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     glBindVertexArray(this->quadVAO);
@@ -102,4 +237,25 @@ void SpriteRenderer::initRenderData()
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
-}
\ No newline at end of file
+}
+
+void SpriteRenderer::initBatchData()
+{
+    glGenVertexArrays(1, &this->batchVAO);
+    glGenBuffers(1, &this->instanceVBO);
+
+    glBindVertexArray(this->batchVAO);
+    // atributo 0: el mismo quad unitario que el modo inmediato
+    glBindBuffer(GL_ARRAY_BUFFER, this->quadVBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    // atributos 1-5: posición, tamaño, rotación, color y rectángulo UV por instancia
+    glBindBuffer(GL_ARRAY_BUFFER, this->instanceVBO);
+    for (unsigned int i = 1; i <= 5; ++i)
+    {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
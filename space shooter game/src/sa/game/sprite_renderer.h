@@ -1,5 +1,6 @@
 #ifndef SPRITE_RENDERER_H
 #define SPRITE_RENDERER_H
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -9,19 +10,61 @@
 #include "shader.h"
 
 
+// Datos por instancia que se suben al buffer de instancias del modo por lotes
+struct SpriteInstance {
+    glm::vec2 Position;
+    glm::vec2 Size;
+    float     Rotation;
+    glm::vec3 Color;
+    glm::vec4 UV;
+};
+
+// Contadores del modo por lotes; se reinician con ResetStats() al inicio de cada frame, que los
+// acumula en los totales que muestra Report()
+struct SpriteBatchStats {
+    unsigned int Sprites = 0;        // sprites enviados con Submit
+    unsigned int DrawCalls = 0;      // llamadas instanciadas realmente emitidas
+    unsigned int DrawCallsSaved = 0; // llamadas evitadas frente a un DrawSprite por sprite
+};
+
 class SpriteRenderer
 {
 public:
 
+    SpriteBatchStats Stats;
     SpriteRenderer(Shader shader);
+    SpriteRenderer(Shader shader, Shader batchShader);
     ~SpriteRenderer();
     void DrawSprite(Texture2D texture, glm::vec2 position, glm::vec2 size = glm::vec2(10.0f, 10.0f), float rotate = 0.0f, glm::vec3 color = glm::vec3(1.0f));
     void DrawSprites(Texture2D texture, glm::vec2 position, glm::vec2 size = glm::vec2(10.0f, 10.0f), float rotate = 0.0f, glm::vec3 color = glm::vec3(1.0f));
+    // modo por lotes: Begin() abre el lote, Submit() acumula y Flush() dibuja un grupo por textura
+    void Begin();
+    void Submit(Texture2D texture, glm::vec2 position, glm::vec2 size = glm::vec2(10.0f, 10.0f), float rotate = 0.0f, glm::vec3 color = glm::vec3(1.0f));
+    void Flush();
+    void ResetStats();
+    // frames, llamadas emitidas y evitadas desde el último Report; después pone los totales a cero
+    void Report();
 private:
 
     Shader       shader; 
+    Shader       batchShader;
+    UniformLocation modelUniform;
+    UniformLocation colorUniform;
+    UniformLocation uvUniform;
     unsigned int quadVAO;
+    unsigned int quadVBO;
+    unsigned int batchVAO;
+    unsigned int instanceVBO;
+    unsigned int instanceCapacity;
+    bool         batching;
+    std::vector<SpriteInstance> instances;
+    std::vector<unsigned int>   instanceTextures;
+    std::vector<unsigned int>   order;
+    std::vector<SpriteInstance> sorted;
+    unsigned int frames;
+    unsigned long long totalSprites, totalDrawCalls, totalSaved;
     void initRenderData();
+    void initBatchData();
 };
 
-#endif
\ No newline at end of file
+#endif
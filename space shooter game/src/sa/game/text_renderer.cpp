@@ -1,110 +1,469 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
-#include <ft2build.h>
-#include FT_FREETYPE_H
 #include "text_renderer.h"
 #include "resource_manager.h"
+#include "baked_font.h"
 
 
 TextRenderer::TextRenderer(unsigned int width, unsigned int height)
+    : staticCapacity(0), atlas(0), vertexCapacity(0), lruHead(-1), lruTail(-1), baseline(0.0f), mode(TEXT_BITMAP), fontSize(0)
 {
-    this->TextShader = ResourceManager::LoadShader("text_2d.vs", "text_2d.fs", nullptr, "text");
-    this->TextShader.SetMatrix4("projection", glm::ortho(0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f), true);
-    this->TextShader.SetInteger("text", 0);
+    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f);
+    this->bitmapShader = ResourceManager::LoadShader("text_2d.vs", "text_2d.fs", nullptr, "text");
+    this->bitmapShader.SetMatrix4("projection", projection, true);
+    this->bitmapShader.SetInteger("text", 0);
+    this->sdfShader = ResourceManager::LoadShader("text_2d.vs", "text_sdf.fs", nullptr, "text_sdf");
+    this->sdfShader.SetMatrix4("projection", projection, true);
+    this->sdfShader.SetInteger("text", 0);
+    this->TextShader = this->bitmapShader;
+    this->textColorUniform = this->TextShader.GetUniform("textColor");
     glGenVertexArrays(1, &this->VAO);
     glGenBuffers(1, &this->VBO);
     glBindVertexArray(this->VAO);
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+    glGenVertexArrays(1, &this->staticVAO);
+    glGenBuffers(1, &this->staticVBO);
+    glBindVertexArray(this->staticVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, this->staticVBO);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void TextRenderer::Load(std::string font, unsigned int fontSize)
+TextRenderer::~TextRenderer()
+{
+    glDeleteTextures(1, &this->atlas);
+    glDeleteBuffers(1, &this->VBO);
+    glDeleteVertexArrays(1, &this->VAO);
+    glDeleteBuffers(1, &this->staticVBO);
+    glDeleteVertexArrays(1, &this->staticVAO);
+}
+
+void TextRenderer::Load(std::string font, unsigned int fontSize, TextMode mode, unsigned int atlasSize)
+{
+    auto start = std::chrono::steady_clock::now();
+    this->rasterizer.Close();
+    this->mode = mode;
+    this->fontFile = font;
+    this->fontSize = fontSize;
+    this->TextShader = mode == TEXT_SDF ? this->sdfShader : this->bitmapShader;
+    this->textColorUniform = this->TextShader.GetUniform("textColor");
+    this->slots.clear();
+
+    // la versión horneada por font_baker evita FreeType; si no está, se rasteriza aquí
+    std::string bakedFile = BakedFontPath(font, fontSize, mode);
+    bool baked = this->loadBaked(bakedFile);
+    if (!baked)
+    {
+        if (!this->openRasterizer())
+            return;
+        this->atlasSize = atlasSize;
+        this->cellWidth = this->rasterizer.CellWidth;
+        this->cellHeight = this->rasterizer.CellHeight;
+        if (!this->createAtlas(nullptr))
+            return;
+        // ASCII imprimible se usa siempre; el resto se rasteriza cuando aparece
+        for (unsigned int c = 32; c < 127; ++c)
+            this->Glyph(c);
+    }
+    this->baseline = static_cast<float>(this->Glyph('H').Bearing.y);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "FONT: " << (baked ? bakedFile : font) << " " << fontSize << "px " << (mode == TEXT_SDF ? "sdf" : "bitmap") << ", " << this->slots.size() << " glyph cells of " << this->cellWidth << "x" << this->cellHeight
+              << " in " << this->atlasSize << "x" << this->atlasSize << " (" << this->atlasSize * this->atlasSize / 1024 << " KB), loaded in " << elapsed << " ms" << std::endl;
+    // las coordenadas UV de los textos persistentes ya no son válidas
+    for (TextLabel &label : this->labels)
+        label.Dirty = true;
+}
+
+// Reparte la página en celdas y la sube; pixels nulo deja la página vacía
+bool TextRenderer::createAtlas(const unsigned char *pixels)
 {
-    this->Characters.clear();
-    FT_Library ft;    
-    if (FT_Init_FreeType(&ft)) 
-        std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
-    FT_Face face;
-    if (FT_New_Face(ft, font.c_str(), 0, &face))
-        std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
-    FT_Set_Pixel_Sizes(face, 0, fontSize);
+    this->cellColumns = this->atlasSize / this->cellWidth;
+    unsigned int cells = this->cellColumns * (this->atlasSize / this->cellHeight);
+    if (cells == 0)
+    {
+        std::cout << "ERROR::FREETYPE: Glyph atlas of " << this->atlasSize << "px cannot hold a " << this->fontSize << "px glyph" << std::endl;
+        return false;
+    }
+    // lista LRU inicial con la celda 0 al final: las libres se usan antes de expulsar nada
+    this->slots.assign(cells, GlyphSlot());
+    for (unsigned int i = 0; i < cells; ++i)
+    {
+        this->slots[i].Prev = i + 1 < cells ? static_cast<int>(i) + 1 : -1;
+        this->slots[i].Next = static_cast<int>(i) - 1;
+    }
+    this->lruHead = static_cast<int>(cells) - 1;
+    this->lruTail = 0;
+    this->glyphIndex.Clear(cells * 2);
+
+    // cada glifo nuevo se copia después a su celda con glTexSubImage2D
+    if (this->atlas == 0)
+        glGenTextures(1, &this->atlas);
+    glBindTexture(GL_TEXTURE_2D, this->atlas);
+    std::vector<unsigned char> clear;
+    if (!pixels)
+    {
+        clear.assign(this->atlasSize * this->atlasSize, 0);
+        pixels = clear.data();
+    }
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1); 
-    for (GLubyte i = 0; i < 128; i++) 
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, this->atlasSize, this->atlasSize, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return true;
+}
+
+// Carga una fuente horneada (baked_font.h): una lectura y una subida de textura
+bool TextRenderer::loadBaked(const std::string &file)
+{
+    AssetView view;
+    if (!AssetPack::Load(file.c_str(), view) || view.Size < sizeof(BakedFontHeader))
+        return false;
+    BakedFontHeader header;
+    std::memcpy(&header, view.Data, sizeof(header));
+    std::size_t expected = sizeof(header) + header.GlyphCount * sizeof(BakedGlyph) + static_cast<std::size_t>(header.AtlasSize) * header.AtlasSize;
+    if (std::memcmp(header.Magic, BAKED_FONT_MAGIC, 4) != 0 || header.Version != BAKED_FONT_VERSION || view.Size != expected
+        || header.Mode != static_cast<std::uint32_t>(this->mode) || header.FontSize != this->fontSize || header.CellWidth == 0 || header.CellHeight == 0)
     {
-        if (FT_Load_Char(face, i, FT_LOAD_RENDER))
-        {
-            std::cout << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
+        std::cout << "ERROR::FONT: " << file << " is not a valid baked font for this size and mode; using FreeType" << std::endl;
+        return false;
+    }
+    this->atlasSize = header.AtlasSize;
+    this->cellWidth = header.CellWidth;
+    this->cellHeight = header.CellHeight;
+    const unsigned char *glyphs = view.Data + sizeof(header);
+    if (!this->createAtlas(glyphs + header.GlyphCount * sizeof(BakedGlyph)))
+        return false;
+    const float texel = 1.0f / this->atlasSize;
+    for (std::uint32_t i = 0; i < header.GlyphCount; ++i)
+    {
+        BakedGlyph glyph;
+        std::memcpy(&glyph, glyphs + i * sizeof(BakedGlyph), sizeof(glyph));
+        if (glyph.Cell >= this->slots.size())
+            continue;
+        GlyphSlot &s = this->slots[glyph.Cell];
+        unsigned int x = (glyph.Cell % this->cellColumns) * this->cellWidth;
+        unsigned int y = (glyph.Cell / this->cellColumns) * this->cellHeight;
+        s.Used = true;
+        s.Codepoint = glyph.Codepoint;
+        s.Glyph.UV = glm::vec4(x * texel, y * texel, (x + glyph.Width) * texel, (y + glyph.Height) * texel);
+        s.Glyph.Size = glm::ivec2(glyph.Width, glyph.Height);
+        s.Glyph.Bearing = glm::ivec2(glyph.BearingX, glyph.BearingY);
+        s.Glyph.Advance = glyph.Advance;
+        this->glyphIndex.Insert(glyph.Codepoint, static_cast<int>(glyph.Cell));
+        this->touch(static_cast<int>(glyph.Cell));
+        ++this->Stats.Baked;
+    }
+    return true;
+}
+
+// FreeType solo se abre cuando hace falta un glifo que no está en el atlas
+bool TextRenderer::openRasterizer()
+{
+    if (this->rasterizer.IsOpen())
+        return true;
+    // FreeType lee la fuente directamente de la vista; debe vivir mientras esté abierto
+    AssetPack::Load(this->fontFile.c_str(), this->fontData);
+    return this->rasterizer.Open(this->fontData.Data, this->fontData.Size, this->fontSize, this->mode);
+}
+
+const Character &TextRenderer::Glyph(unsigned int codepoint)
+{
+    static const Character empty = { glm::vec4(0.0f), glm::ivec2(0), glm::ivec2(0), 0 };
+    if (this->slots.empty())
+        return empty;
+    int slot = this->glyphIndex.Find(codepoint);
+    if (slot < 0)
+        slot = this->rasterize(codepoint);
+    else
+        this->touch(slot);
+    return this->slots[slot].Glyph;
+}
+
+// Pasa la celda a la cabeza de la lista LRU
+void TextRenderer::touch(int slot)
+{
+    if (slot == this->lruHead)
+        return;
+    GlyphSlot &s = this->slots[slot];
+    this->slots[s.Prev].Next = s.Next;
+    if (s.Next >= 0)
+        this->slots[s.Next].Prev = s.Prev;
+    else
+        this->lruTail = s.Prev;
+    s.Prev = -1;
+    s.Next = this->lruHead;
+    this->slots[this->lruHead].Prev = slot;
+    this->lruHead = slot;
+}
+
+// Rasteriza el glifo en la celda menos usada, expulsando el glifo que tuviera
+int TextRenderer::rasterize(unsigned int codepoint)
+{
+    int slot = this->lruTail;
+    GlyphSlot &s = this->slots[slot];
+    if (s.Used)
+    {
+        this->glyphIndex.Erase(s.Codepoint);
+        ++this->Stats.Evicted;
+        for (TextLabel &label : this->labels) // pueden estar usando la celda
+            label.Dirty = true;
+    }
+    this->touch(slot);
+    this->glyphIndex.Insert(codepoint, slot);
+    s.Used = true;
+    s.Codepoint = codepoint;
+    s.Glyph = Character();
+    // un glifo que falla se guarda vacío para no reintentarlo en cada frame
+    GlyphBitmap glyph;
+    if (!this->openRasterizer() || !this->rasterizer.Rasterize(codepoint, glyph))
+    {
+        std::cout << "ERROR::FREETYTPE: Failed to load Glyph " << codepoint << std::endl;
+        return slot;
+    }
+    ++this->Stats.Rasterized;
+    unsigned int x = (slot % this->cellColumns) * this->cellWidth;
+    unsigned int y = (slot / this->cellColumns) * this->cellHeight;
+    unsigned int w = std::min(static_cast<unsigned int>(glyph.Width), this->cellWidth - 1);
+    unsigned int h = std::min(static_cast<unsigned int>(glyph.Height), this->cellHeight - 1);
+    if (w > 0 && h > 0)
+    {
+        glBindTexture(GL_TEXTURE_2D, this->atlas);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); 
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, glyph.Pitch);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE, glyph.Pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    const float texel = 1.0f / this->atlasSize;
+    s.Glyph.UV = glm::vec4(x * texel, y * texel, (x + w) * texel, (y + h) * texel);
+    s.Glyph.Size = glm::ivec2(w, h);
+    s.Glyph.Bearing = glyph.Bearing;
+    s.Glyph.Advance = glyph.Advance;
+    return slot;
+}
+
+// Decodifica el siguiente codepoint UTF-8 de [p, end) y avanza p; las secuencias inválidas dan U+FFFD
+static unsigned int decodeUTF8(const char *&p, const char *end)
+{
+    unsigned char lead = static_cast<unsigned char>(*p++);
+    if (lead < 0x80)
+        return lead;
+    unsigned int extra, codepoint;
+    if ((lead & 0xE0) == 0xC0)      { extra = 1; codepoint = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { extra = 2; codepoint = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { extra = 3; codepoint = lead & 0x07; }
+    else
+        return 0xFFFD;
+    for (unsigned int i = 0; i < extra; ++i)
+    {
+        if (p == end || (static_cast<unsigned char>(*p) & 0xC0) != 0x80)
+            return 0xFFFD;
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(*p++) & 0x3F);
+    }
+    return codepoint;
+}
+
+// Escribe en out los quads de text (UTF-8; 6 vértices de 4 floats por glifo visible) y avanza x;
+// devuelve los vértices escritos. out debe tener sitio para length glifos.
+unsigned int TextRenderer::layout(const char *text, std::size_t length, float &x, float y, float scale, float *out)
+{
+    unsigned int count = 0;
+    const char *end = text + length;
+    while (text < end)
+    {
+        const Character &ch = this->Glyph(decodeUTF8(text, end));
+
+        float xpos = x + ch.Bearing.x * scale;
+        float ypos = y + (this->baseline - ch.Bearing.y) * scale;
+        x += (ch.Advance >> 6) * scale; 
+        if (ch.Size.x == 0 || ch.Size.y == 0) // espacios: solo avanzan
             continue;
-        }
-        unsigned int texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
-            );
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-      
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<unsigned int>(face->glyph->advance.x)
+
+        float w = ch.Size.x * scale;
+        float h = ch.Size.y * scale;
+        const glm::vec4 &uv = ch.UV;
+        float quad[6][4] = {
+            { xpos,     ypos + h,   uv.x, uv.w },
+            { xpos + w, ypos,       uv.z, uv.y },
+            { xpos,     ypos,       uv.x, uv.y },
+
+            { xpos,     ypos + h,   uv.x, uv.w },
+            { xpos + w, ypos + h,   uv.z, uv.w },
+            { xpos + w, ypos,       uv.z, uv.y }
         };
-        Characters.insert(std::pair<char, Character>(i, character));
+        std::copy(&quad[0][0], &quad[0][0] + 24, out + count * 4);
+        count += 6;
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    return count;
+}
+
+// Si el layout expulsó glifos, algún quad ya escrito puede apuntar a una celda reutilizada: se repite
+// una vez, con todos los glifos del texto ya a la cabeza del LRU. Si vuelve a expulsar, el texto tiene
+// más glifos distintos que celdas tiene el atlas y no puede dibujarse entero.
+bool TextRenderer::relayout(unsigned int evictedBefore, unsigned int pass)
+{
+    if (this->Stats.Evicted == evictedBefore)
+        return false;
+    if (pass < 2)
+        return true;
+    if (!this->overflowReported)
+        std::cout << "ERROR::FONT: Text needs more distinct glyphs than the " << this->slots.size() << " atlas cells; increase atlasSize" << std::endl;
+    this->overflowReported = true;
+    return false;
 }
 
 void TextRenderer::RenderText(std::string text, float x, float y, float scale, glm::vec3 color)
 {	
+    // Genera los quads de toda la cadena y los sube de una vez
+    this->vertices.resize(text.size() * 24);
+    unsigned int count;
+    float startX = x;
+    unsigned int pass = 0, evicted;
+    do
+    {
+        x = startX;
+        evicted = this->Stats.Evicted;
+        count = this->layout(text.data(), text.size(), x, y, scale, this->vertices.data());
+    } while (this->relayout(evicted, ++pass));
+    if (count == 0)
+        return;
+
     this->TextShader.Use();
-    this->TextShader.SetVector3f("textColor", color);
+    this->TextShader.SetVector3f(this->textColorUniform, color);
     glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, this->atlas);
     glBindVertexArray(this->VAO);
-
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++)
+    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+    if (count > this->vertexCapacity)
     {
-        Character ch = Characters[*c];
+        this->vertexCapacity = count;
+        glBufferData(GL_ARRAY_BUFFER, count * 4 * sizeof(float), this->vertices.data(), GL_DYNAMIC_DRAW);
+    }
+    else
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * 4 * sizeof(float), this->vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArrays(GL_TRIANGLES, 0, count);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-        float xpos = x + ch.Bearing.x * scale;
-        float ypos = y + (this->Characters['H'].Bearing.y - ch.Bearing.y) * scale;
+int TextRenderer::CreateLabel(const std::string &text, float x, float y, float scale, glm::vec3 color, unsigned int capacity)
+{
+    TextLabel label;
+    label.Text = text;
+    label.Position = glm::vec2(x, y);
+    label.Scale = scale;
+    label.Color = color;
+    label.Capacity = std::max(capacity, static_cast<unsigned int>(text.size()));
+    label.First = static_cast<unsigned int>(this->staticVertices.size() / 4);
+    this->staticVertices.resize(this->staticVertices.size() + label.Capacity * 24);
+    this->labels.push_back(label);
+    return static_cast<int>(this->labels.size() - 1);
+}
 
-        float w = ch.Size.x * scale;
-        float h = ch.Size.y * scale;
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 0.0f },
-            { xpos,     ypos,       0.0f, 0.0f },
-
-            { xpos,     ypos + h,   0.0f, 1.0f },
-            { xpos + w, ypos + h,   1.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 0.0f }
-        };
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        x += (ch.Advance >> 6) * scale; 
+void TextRenderer::SetLabelText(int id, const std::string &text)
+{
+    TextLabel &label = this->labels[id];
+    if (label.Text == text)
+        return;
+    label.Text = text;
+    label.Dirty = true;
+}
+
+void TextRenderer::SetLabelNumber(int id, int value)
+{
+    TextLabel &label = this->labels[id];
+    if (label.HasNumber && label.Number == value)
+        return;
+    label.HasNumber = true;
+    label.Number = value;
+    label.Dirty = true;
+}
+
+void TextRenderer::SetLabelPosition(int id, float x, float y)
+{
+    TextLabel &label = this->labels[id];
+    if (label.Position == glm::vec2(x, y))
+        return;
+    label.Position = glm::vec2(x, y);
+    label.Dirty = true;
+}
+
+void TextRenderer::SetLabelColor(int id, glm::vec3 color)
+{
+    this->labels[id].Color = color; // es un uniform: no hace falta regenerar
+}
+
+// Regenera los quads del texto en su tramo y sube solo ese tramo
+void TextRenderer::rebuild(TextLabel &label)
+{
+    // el número se escribe de derecha a izquierda en un buffer fijo (cabe INT_MIN)
+    char digits[12];
+    unsigned int digitCount = 0;
+    if (label.HasNumber)
+    {
+        unsigned int magnitude = label.Number < 0 ? 0u - static_cast<unsigned int>(label.Number) : static_cast<unsigned int>(label.Number);
+        do
+        {
+            digits[11 - digitCount++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (label.Number < 0)
+            digits[11 - digitCount++] = '-';
+    }
+    unsigned int length = static_cast<unsigned int>(label.Text.size()) + digitCount;
+    if (length > label.Capacity)
+    {
+        // no cabe: se recoloca al final con margen; el tramo viejo queda sin usar
+        label.Capacity = length + 8;
+        label.First = static_cast<unsigned int>(this->staticVertices.size() / 4);
+        this->staticVertices.resize(this->staticVertices.size() + label.Capacity * 24);
+    }
+    float *out = this->staticVertices.data() + label.First * 4;
+    unsigned int pass = 0, evicted;
+    do
+    {
+        float x = label.Position.x;
+        evicted = this->Stats.Evicted;
+        label.Count = this->layout(label.Text.data(), label.Text.size(), x, label.Position.y, label.Scale, out);
+        label.Count += this->layout(digits + 12 - digitCount, digitCount, x, label.Position.y, label.Scale, out + label.Count * 4);
+    } while (this->relayout(evicted, ++pass));
+    label.Dirty = false; // las expulsiones de este layout también la marcaron
+
+    glBindBuffer(GL_ARRAY_BUFFER, this->staticVBO);
+    unsigned int total = static_cast<unsigned int>(this->staticVertices.size() / 4);
+    if (total > this->staticCapacity)
+    {
+        this->staticCapacity = total;
+        glBufferData(GL_ARRAY_BUFFER, total * 4 * sizeof(float), this->staticVertices.data(), GL_DYNAMIC_DRAW);
     }
+    else
+        glBufferSubData(GL_ARRAY_BUFFER, label.First * 4 * sizeof(float), label.Count * 4 * sizeof(float), out);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TextRenderer::RenderLabel(int id)
+{
+    TextLabel &label = this->labels[id];
+    if (label.Dirty)
+        this->rebuild(label);
+    if (label.Count == 0)
+        return;
+    this->TextShader.Use();
+    this->TextShader.SetVector3f(this->textColorUniform, label.Color);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, this->atlas);
+    glBindVertexArray(this->staticVAO);
+    glDrawArrays(GL_TRIANGLES, label.First, label.Count);
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
\ No newline at end of file
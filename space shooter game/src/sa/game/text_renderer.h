@@ -1,30 +1,111 @@
 #ifndef TEXT_RENDERER_H
 #define TEXT_RENDERER_H
-#include <map>
+#include <string>
+#include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include "texture.h"
 #include "shader.h"
+#include "asset_pack.h"
+#include "glyph_map.h"
+#include "glyph_rasterizer.h"
+
 
 struct Character {
-    unsigned int TextureID; 
+    glm::vec4    UV;        // (u0, v0, u1, v1) dentro del atlas de glifos
     glm::ivec2   Size;      
     glm::ivec2   Bearing;  
     unsigned int Advance;  
 };
 
+// Contadores acumulados del caché de glifos
+struct GlyphStats {
+    unsigned int Baked = 0;      // glifos cargados de la fuente horneada
+    unsigned int Rasterized = 0; // glifos generados con FreeType
+    unsigned int Evicted = 0;    // glifos expulsados por falta de celdas (LRU)
+};
+
+// Todos los glifos viven en una única textura; cada cadena se dibuja con una sola llamada.
+// El texto es UTF-8: los glifos se rasterizan al usarse por primera vez y, si el atlas se
+// llena, se reutiliza la celda del glifo usado hace más tiempo. Si existe la fuente horneada
+// por font_baker (BakedFontPath) se carga esa y FreeType solo se abre para glifos que no traiga.
+// Los textos persistentes (CreateLabel) guardan sus quads en un tramo propio de un VBO y solo
+// se regeneran cuando cambia su contenido, posición o escala.
 class TextRenderer
 {
 public:
 
-    std::map<char, Character> Characters; 
-    Shader TextShader;
+    Shader TextShader; // el del modo cargado
+    GlyphStats Stats;
     TextRenderer(unsigned int width, unsigned int height);
-    void Load(std::string font, unsigned int fontSize);
+    ~TextRenderer();
+    // atlasSize: lado en píxeles de la página de glifos; limita cuántos glifos hay a la vez
+    // (una fuente horneada trae el suyo)
+    void Load(std::string font, unsigned int fontSize, TextMode mode = TEXT_BITMAP, unsigned int atlasSize = GLYPH_ATLAS_SIZE);
+    // glifo del codepoint, rasterizándolo si no está en el atlas
+    const Character &Glyph(unsigned int codepoint);
     void RenderText(std::string text, float x, float y, float scale, glm::vec3 color = glm::vec3(1.0f));
+    // capacity: caracteres a reservar; el tramo se recoloca si el texto crece más
+    int  CreateLabel(const std::string &text, float x, float y, float scale, glm::vec3 color = glm::vec3(1.0f), unsigned int capacity = 0);
+    void SetLabelText(int id, const std::string &text);
+    // muestra el texto seguido de value; sin formatear cadenas ni reservar memoria, y sin coste si no cambió
+    void SetLabelNumber(int id, int value);
+    void SetLabelPosition(int id, float x, float y);
+    void SetLabelColor(int id, glm::vec3 color);
+    void RenderLabel(int id);
 
 private:
+    struct TextLabel {
+        std::string  Text;
+        glm::vec2    Position;
+        float        Scale;
+        glm::vec3    Color;
+        bool         HasNumber = false;
+        int          Number = 0;
+        unsigned int First = 0;    // primer vértice del tramo en staticVBO
+        unsigned int Capacity = 0; // caracteres que caben en el tramo
+        unsigned int Count = 0;    // vértices generados
+        bool         Dirty = true;
+    };
+    std::vector<TextLabel> labels;
+    std::vector<float> staticVertices; // copia en CPU de staticVBO
+    unsigned int staticVAO, staticVBO;
+    unsigned int staticCapacity;       // vértices reservados en staticVBO
+    unsigned int layout(const char *text, std::size_t length, float &x, float y, float scale, float *out);
+    void rebuild(TextLabel &label);
+    // true si hay que repetir el layout por expulsiones (como mucho dos pasadas)
+    bool relayout(unsigned int evictedBefore, unsigned int pass);
+    bool overflowReported = false;
+
     unsigned int VAO, VBO;
+    unsigned int atlas;
+    unsigned int vertexCapacity; // vértices que caben en VBO
+    std::vector<float> vertices; // se reutiliza entre llamadas para no reservar memoria cada frame
+    // el atlas se divide en celdas iguales, una por glifo, que se reutilizan en orden LRU
+    struct GlyphSlot {
+        Character    Glyph;
+        unsigned int Codepoint = 0;
+        bool         Used = false;
+        int          Prev = -1, Next = -1; // lista LRU; la cabeza es el más reciente
+    };
+    std::vector<GlyphSlot> slots;
+    GlyphMap glyphIndex; // codepoint -> celda
+    int lruHead, lruTail;
+    unsigned int atlasSize, cellWidth, cellHeight, cellColumns;
+    float baseline;
+    // FreeType se abre al primer glifo que no esté en el atlas; la fuente vive en fontData
+    TextMode mode;
+    std::string fontFile;
+    unsigned int fontSize;
+    GlyphRasterizer rasterizer;
+    AssetView fontData;
+    bool createAtlas(const unsigned char *pixels);
+    bool loadBaked(const std::string &file);
+    bool openRasterizer();
+    void touch(int slot);
+    int rasterize(unsigned int codepoint);
+    UniformLocation textColorUniform;
+    Shader bitmapShader, sdfShader;
 };
 
-#endif 
\ No newline at end of file
+#endif
@@ -0,0 +1,15 @@
+#version 330 core
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D text;
+uniform vec3 textColor;
+
+void main()
+{
+    // the atlas stores a distance field with the glyph edge at 0.5; fwidth keeps the
+    // antialiased band about one screen pixel wide whatever the text scale
+    float distance = texture(text, TexCoords).r;
+    float width = max(fwidth(distance) * 0.7, 0.0001);
+    color = vec4(textColor, smoothstep(0.5 - width, 0.5 + width, distance));
+}
\ No newline at end of file
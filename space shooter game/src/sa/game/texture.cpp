@@ -3,15 +3,17 @@
 
 
 Texture2D::Texture2D()
-    : Width(0), Height(0), Internal_Format(GL_RGB), Image_Format(GL_RGB), Wrap_S(GL_REPEAT), Wrap_T(GL_REPEAT), Filter_Min(GL_LINEAR), Filter_Max(GL_LINEAR)
+    : ID(0), Width(0), Height(0), Internal_Format(GL_RGB), Image_Format(GL_RGB), Wrap_S(GL_REPEAT), Wrap_T(GL_REPEAT), Filter_Min(GL_LINEAR), Filter_Max(GL_LINEAR), UV(0.0f, 0.0f, 1.0f, 1.0f)
 {
-    glGenTextures(1, &this->ID);
 }
 
 void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char* data)
 {
     this->Width = width;
     this->Height = height;
+    // el nombre GL se crea al subir datos, así las copias y los handles de atlas no reservan uno
+    if (this->ID == 0)
+        glGenTextures(1, &this->ID);
     glBindTexture(GL_TEXTURE_2D, this->ID);
     glTexImage2D(GL_TEXTURE_2D, 0, this->Internal_Format, width, height, 0, this->Image_Format, GL_UNSIGNED_BYTE, data);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, this->Wrap_S);
@@ -21,6 +23,38 @@ void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char*
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+void Texture2D::Generate(unsigned int width, unsigned int height, const unsigned char* data, unsigned int levels, unsigned int channels)
+{
+    if (levels <= 1)
+    {
+        this->Generate(width, height, const_cast<unsigned char*>(data));
+        return;
+    }
+    this->Width = width;
+    this->Height = height;
+    if (this->ID == 0)
+        glGenTextures(1, &this->ID);
+    // los niveles pequeños no tienen filas alineadas a 4 bytes
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, this->ID);
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        glTexImage2D(GL_TEXTURE_2D, level, this->Internal_Format, width, height, 0, this->Image_Format, GL_UNSIGNED_BYTE, data);
+        data += static_cast<std::size_t>(width) * height * channels;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, this->Wrap_S);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, this->Wrap_T);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->Filter_Min);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, this->Filter_Max);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
 void Texture2D::Bind() const
 {
     glBindTexture(GL_TEXTURE_2D, this->ID);
@@ -2,6 +2,7 @@
 #define TEXTURE_H
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 
 class Texture2D
 {
@@ -15,8 +16,13 @@ public:
     unsigned int Wrap_T; 
     unsigned int Filter_Min;
     unsigned int Filter_Max; 
+    // sub-rectángulo (u0, v0, u1, v1) dentro de ID; (0, 0, 1, 1) salvo en texturas de atlas
+    glm::vec4    UV;
     Texture2D();
     void Generate(unsigned int width, unsigned int height, unsigned char* data);
+    // sube levels niveles de mip guardados uno tras otro en data (el formato de TextureCache), con
+    // channels bytes por píxel; Image_Format debe describir esos mismos canales
+    void Generate(unsigned int width, unsigned int height, const unsigned char* data, unsigned int levels, unsigned int channels);
     void Bind() const;
 };
 
@@ -0,0 +1,97 @@
+#include "texture_atlas.h"
+
+#include <algorithm>
+#include <climits>
+
+AtlasPacker::AtlasPacker(unsigned int width, unsigned int height)
+{
+    this->Reset(width, height);
+}
+
+// Reinicia la página con un único segmento de skyline a altura 0
+void AtlasPacker::Reset(unsigned int width, unsigned int height)
+{
+    this->Width = width;
+    this->Height = height;
+    this->skyline.clear();
+    this->skyline.push_back({ 0, 0, width });
+}
+
+bool AtlasPacker::Pack(unsigned int w, unsigned int h, unsigned int &x, unsigned int &y)
+{
+    // Elige el segmento donde el rectángulo queda más abajo; en empate, el segmento más estrecho
+    unsigned int bestIndex = UINT_MAX, bestBottom = UINT_MAX, bestWidth = UINT_MAX;
+    for (unsigned int i = 0; i < this->skyline.size(); ++i)
+    {
+        int top = this->fit(i, w, h);
+        if (top < 0)
+            continue;
+        unsigned int bottom = static_cast<unsigned int>(top) + h;
+        if (bottom < bestBottom || (bottom == bestBottom && this->skyline[i].Width < bestWidth))
+        {
+            bestIndex = i;
+            bestBottom = bottom;
+            bestWidth = this->skyline[i].Width;
+            x = this->skyline[i].X;
+            y = static_cast<unsigned int>(top);
+        }
+    }
+    if (bestIndex == UINT_MAX)
+        return false;
+    this->insert(bestIndex, x, y, w, h);
+    return true;
+}
+
+// Altura a la que cabe un rectángulo que empieza en el segmento index, o -1 si no cabe
+int AtlasPacker::fit(unsigned int index, unsigned int w, unsigned int h)
+{
+    unsigned int x = this->skyline[index].X;
+    if (x + w > this->Width)
+        return -1;
+    unsigned int y = 0;
+    int widthLeft = static_cast<int>(w);
+    while (widthLeft > 0)
+    {
+        if (index >= this->skyline.size())
+            return -1;
+        y = std::max(y, this->skyline[index].Y);
+        if (y + h > this->Height)
+            return -1;
+        widthLeft -= static_cast<int>(this->skyline[index].Width);
+        ++index;
+    }
+    return static_cast<int>(y);
+}
+
+// Añade el nuevo segmento y recorta o elimina los que quedan debajo
+void AtlasPacker::insert(unsigned int index, unsigned int x, unsigned int y, unsigned int w, unsigned int h)
+{
+    this->skyline.insert(this->skyline.begin() + index, { x, y + h, w });
+    for (unsigned int i = index + 1; i < this->skyline.size(); )
+    {
+        SkylineNode &previous = this->skyline[i - 1];
+        SkylineNode &node = this->skyline[i];
+        if (node.X >= previous.X + previous.Width)
+            break;
+        unsigned int shrink = previous.X + previous.Width - node.X;
+        if (node.Width <= shrink)
+        {
+            this->skyline.erase(this->skyline.begin() + i);
+            continue;
+        }
+        node.X += shrink;
+        node.Width -= shrink;
+        break;
+    }
+    // Une segmentos contiguos a la misma altura
+    for (unsigned int i = 0; i + 1 < this->skyline.size(); )
+    {
+        if (this->skyline[i].Y == this->skyline[i + 1].Y)
+        {
+            this->skyline[i].Width += this->skyline[i + 1].Width;
+            this->skyline.erase(this->skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+#include <vector>
+
+// Empaquetador skyline (bottom-left) para una página de atlas de tamaño fijo.
+// Solo calcula posiciones; la subida a GL la hace quien lo usa.
+class AtlasPacker
+{
+public:
+
+    unsigned int Width, Height;
+    AtlasPacker(unsigned int width = 0, unsigned int height = 0);
+    void Reset(unsigned int width, unsigned int height);
+    // busca sitio para un rectángulo w x h; devuelve false si no cabe en la página
+    bool Pack(unsigned int w, unsigned int h, unsigned int &x, unsigned int &y);
+
+private:
+
+    struct SkylineNode {
+        unsigned int X, Y, Width;
+    };
+    std::vector<SkylineNode> skyline;
+    int fit(unsigned int index, unsigned int w, unsigned int h);
+    void insert(unsigned int index, unsigned int x, unsigned int y, unsigned int w, unsigned int h);
+};
+
+#endif
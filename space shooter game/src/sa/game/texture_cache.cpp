@@ -0,0 +1,220 @@
+#include "texture_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "resource_id.h"
+#include "resource_manager.h"
+#include "stb_image.h"
+
+std::string TextureCache::Directory = "cache/";
+std::atomic<unsigned int> TextureCache::hits(0);
+std::atomic<unsigned int> TextureCache::misses(0);
+std::atomic<std::int64_t> TextureCache::savedMicros(0);
+
+// Posición de los píxeles dentro del archivo: tras la cabecera y la clave, alineada a 16
+static std::size_t pixelOffset(std::uint32_t keyLength)
+{
+    return (sizeof(TextureCacheHeader) + keyLength + 15) & ~static_cast<std::size_t>(15);
+}
+
+// Bytes de una cadena de levels niveles empezando en width x height
+static std::size_t chainSize(int width, int height, int channels, unsigned int levels)
+{
+    std::size_t total = 0;
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        total += static_cast<std::size_t>(width) * height * channels;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return total;
+}
+
+CachedImage::~CachedImage()
+{
+    if (this->Decoded)
+        stbi_image_free(this->Decoded);
+}
+
+unsigned char *CachedImage::Release()
+{
+    unsigned char *pixels = this->Decoded;
+    if (!pixels && this->Data)
+    {
+        std::size_t bytes = static_cast<std::size_t>(this->Width) * this->Height * this->Channels;
+        pixels = static_cast<unsigned char*>(std::malloc(bytes)); // stbi_image_free es free()
+        std::memcpy(pixels, this->Data, bytes);
+    }
+    this->Decoded = nullptr;
+    this->Data = nullptr;
+    return pixels;
+}
+
+bool TextureCache::Decode(const char *file, bool alpha, int channels, bool mipmaps, CachedImage &image)
+{
+    std::string path = Directory.empty() ? std::string() : cacheFile(file, alpha, channels, mipmaps);
+    std::int64_t time = 0;
+    if (!AssetPack::Timestamp(file, time))
+        path.clear();
+    if (!path.empty() && load(path, file, time, image))
+        return true;
+
+    // Fallo: decodifica con stb_image y deja la entrada para el próximo arranque
+    auto start = std::chrono::steady_clock::now();
+    AssetView bytes;
+    AssetPack::Load(file, bytes);
+    image.Key = ResourceManager::TextureKey(file, bytes.Data, bytes.Size, alpha);
+    if (bytes.Size == 0)
+        return false;
+    int sourceChannels = 0;
+    image.Decoded = stbi_load_from_memory(bytes.Data, static_cast<int>(bytes.Size), &image.Width, &image.Height, &sourceChannels, channels);
+    if (!image.Decoded)
+        return false;
+    image.Channels = channels ? channels : sourceChannels;
+    image.Levels = 1;
+    image.Data = image.Decoded;
+    if (mipmaps)
+    {
+        // Cadena de mips con filtro de caja 2x2 hasta llegar a 1x1
+        std::size_t base = static_cast<std::size_t>(image.Width) * image.Height * image.Channels;
+        int width = image.Width, height = image.Height;
+        image.Levels = 1;
+        while (width > 1 || height > 1)
+        {
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            ++image.Levels;
+        }
+        image.Storage.resize(chainSize(image.Width, image.Height, image.Channels, image.Levels));
+        std::memcpy(image.Storage.data(), image.Decoded, base);
+        unsigned char *source = image.Storage.data();
+        width = image.Width;
+        height = image.Height;
+        for (unsigned int level = 1; level < image.Levels; ++level)
+        {
+            int nextWidth = std::max(1, width / 2), nextHeight = std::max(1, height / 2);
+            unsigned char *target = source + static_cast<std::size_t>(width) * height * image.Channels;
+            for (int y = 0; y < nextHeight; ++y)
+            {
+                for (int x = 0; x < nextWidth; ++x)
+                {
+                    int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+                    int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+                    for (int c = 0; c < image.Channels; ++c)
+                    {
+                        int sum = source[(y0 * width + x0) * image.Channels + c] + source[(y0 * width + x1) * image.Channels + c]
+                                + source[(y1 * width + x0) * image.Channels + c] + source[(y1 * width + x1) * image.Channels + c];
+                        target[(y * nextWidth + x) * image.Channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+                    }
+                }
+            }
+            source = target;
+            width = nextWidth;
+            height = nextHeight;
+        }
+        image.Data = image.Storage.data();
+    }
+    ++misses;
+    std::uint64_t micros = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    if (!path.empty())
+        store(path, time, bytes.Size, micros, image);
+    return true;
+}
+
+void TextureCache::Report()
+{
+    std::cout << "TEXTURE CACHE: " << hits << " hit(s), " << misses << " miss(es), "
+              << savedMicros / 1000 << " ms of decoding saved" << std::endl;
+}
+
+// Un archivo por ruta y formato pedido: cache/<hash>.tex
+std::string TextureCache::cacheFile(const char *file, bool alpha, int channels, bool mipmaps)
+{
+    std::string id = std::string(file) + (alpha ? ":rgba:" : ":rgb:") + std::to_string(channels) + (mipmaps ? ":mips" : "");
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(ResourceID(id.c_str()).Hash));
+    return Directory + hex + ".tex";
+}
+
+bool TextureCache::load(const std::string &path, const char *file, std::int64_t time, CachedImage &image)
+{
+    auto start = std::chrono::steady_clock::now();
+    if (!image.File.Open(path.c_str()))
+        return false;
+    const unsigned char *data = image.File.Data();
+    const TextureCacheHeader *header = reinterpret_cast<const TextureCacheHeader*>(data);
+    // Entrada caducada (PNG modificado) o incompleta: se regenera
+    if (image.File.Size() < sizeof(TextureCacheHeader) || std::memcmp(header->Magic, TEXTURE_CACHE_MAGIC, 4) != 0
+        || header->Version != TEXTURE_CACHE_VERSION || header->SourceTime != time
+        || image.File.Size() < pixelOffset(header->KeyLength) + chainSize(header->Width, header->Height, header->Channels, header->Levels))
+    {
+        image.File.Close();
+        return false;
+    }
+    // con el paquete montado el tamaño del origen se comprueba en su índice
+    AssetView source;
+    if (AssetPack::IsMounted() && AssetPack::Load(file, source) && source.Size != header->SourceSize)
+    {
+        image.File.Close();
+        return false;
+    }
+    image.Width = static_cast<int>(header->Width);
+    image.Height = static_cast<int>(header->Height);
+    image.Channels = static_cast<int>(header->Channels);
+    image.Levels = header->Levels;
+    image.Key.assign(reinterpret_cast<const char*>(data + sizeof(TextureCacheHeader)), header->KeyLength);
+    image.Data = data + pixelOffset(header->KeyLength);
+    image.Hit = true;
+    ++hits;
+    std::int64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    savedMicros += std::max<std::int64_t>(0, static_cast<std::int64_t>(header->DecodeMicros) - elapsed);
+    return true;
+}
+
+void TextureCache::store(const std::string &path, std::int64_t time, std::uint64_t sourceSize, std::uint64_t decodeMicros, const CachedImage &image)
+{
+    std::error_code error;
+    std::filesystem::create_directories(Directory, error);
+    TextureCacheHeader header;
+    std::memcpy(header.Magic, TEXTURE_CACHE_MAGIC, sizeof(header.Magic));
+    header.Version = TEXTURE_CACHE_VERSION;
+    header.SourceTime = time;
+    header.SourceSize = sourceSize;
+    header.Width = image.Width;
+    header.Height = image.Height;
+    header.Channels = image.Channels;
+    header.Levels = image.Levels;
+    header.DecodeMicros = decodeMicros;
+    header.KeyLength = static_cast<std::uint32_t>(image.Key.size());
+    header.Reserved = 0;
+    // Se escribe en un temporal y se renombra: nunca queda a medias una entrada válida
+    std::string temporary = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        if (!out)
+            return;
+        const char padding[16] = { };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(image.Key.data(), image.Key.size());
+        out.write(padding, pixelOffset(header.KeyLength) - sizeof(header) - image.Key.size());
+        out.write(reinterpret_cast<const char*>(image.Data), chainSize(image.Width, image.Height, image.Channels, image.Levels));
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error)
+        std::filesystem::remove(temporary, error);
+}
@@ -0,0 +1,71 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "asset_pack.h"
+
+// Formato de cada archivo de la caché (uno por imagen y formato pedido):
+//   TextureCacheHeader | clave de deduplicación (KeyLength bytes) | relleno a 16 | píxeles
+// Los píxeles son el nivel 0 seguido de cada nivel de mip, ya listos para glTexImage2D.
+const char          TEXTURE_CACHE_MAGIC[4] = { 'S', 'A', 'T', 'C' };
+const std::uint32_t TEXTURE_CACHE_VERSION = 1;
+
+struct TextureCacheHeader {
+    char          Magic[4];
+    std::uint32_t Version;
+    std::int64_t  SourceTime;    // AssetPack::Timestamp del PNG al generar la entrada
+    std::uint64_t SourceSize;
+    std::uint32_t Width, Height, Channels, Levels;
+    std::uint64_t DecodeMicros;  // lo que tardó stb_image; de aquí sale el tiempo ahorrado
+    std::uint32_t KeyLength;
+    std::uint32_t Reserved;
+};
+
+// Píxeles decodificados: apuntan al archivo de caché mapeado o a memoria de stb_image
+struct CachedImage {
+    int          Width = 0, Height = 0, Channels = 0;
+    unsigned int Levels = 0;  // niveles guardados uno tras otro en Data (1 = sin mips)
+    const unsigned char *Data = nullptr;
+    std::string  Key;         // la de ResourceManager::TextureKey
+    bool         Hit = false;
+
+    CachedImage() { }
+    ~CachedImage();
+    CachedImage(const CachedImage &) = delete;
+    CachedImage &operator=(const CachedImage &) = delete;
+    // el nivel 0 en memoria propia que se libera con stbi_image_free (copia si viene de la caché)
+    unsigned char *Release();
+
+    MappedFile     File;
+    unsigned char *Decoded = nullptr;
+    std::vector<unsigned char> Storage;
+};
+
+// Caché en disco de texturas ya decodificadas, indexada por ruta y validada por hora de
+// modificación y tamaño del PNG. En un acierto no se lee ni decodifica el PNG: los píxeles
+// se suben directamente desde el archivo mapeado. Segura desde varios hilos a la vez.
+class TextureCache
+{
+public:
+
+    static std::string Directory; // "" desactiva la caché
+    // decodifica file con channels canales (0: los del PNG); alpha solo elige la clave de deduplicación
+    // y mipmaps también guarda la cadena de mips
+    static bool Decode(const char *file, bool alpha, int channels, bool mipmaps, CachedImage &image);
+    static void Report();
+
+private:
+
+    TextureCache() { }
+    static std::atomic<unsigned int> hits, misses;
+    static std::atomic<std::int64_t> savedMicros;
+    static std::string cacheFile(const char *file, bool alpha, int channels, bool mipmaps);
+    static bool        load(const std::string &path, const char *file, std::int64_t time, CachedImage &image);
+    static void        store(const std::string &path, std::int64_t time, std::uint64_t sourceSize, std::uint64_t decodeMicros, const CachedImage &image);
+};
+
+#endif
@@ -0,0 +1,102 @@
+// Empaqueta los recursos del juego en un único archivo para AssetPack::Mount.
+// Uso: asset_packer <salida.pak> <directorio raíz>
+// Las rutas se guardan relativas a la raíz y con '/', igual que las pide el juego.
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "asset_pack.h"
+#include "resource_id.h"
+
+namespace fs = std::filesystem;
+
+struct PackFile {
+    std::string                Path;
+    std::uint64_t              Hash;
+    std::vector<unsigned char> Data;
+};
+
+static bool isAsset(const fs::path &path)
+{
+    static const char *extensions[] = { ".png", ".jpg", ".ttf", ".TTF", ".font", ".lvl", ".vs", ".fs", ".gs", ".mp3", ".wav" };
+    std::string extension = path.extension().string();
+    for (const char *candidate : extensions)
+        if (extension == candidate)
+            return true;
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cout << "usage: asset_packer <output.pak> <root directory>" << std::endl;
+        return 1;
+    }
+    fs::path root(argv[2]);
+    std::vector<PackFile> files;
+    for (const fs::directory_entry &entry : fs::recursive_directory_iterator(root))
+    {
+        if (!entry.is_regular_file() || !isAsset(entry.path()))
+            continue;
+        PackFile file;
+        file.Path = fs::relative(entry.path(), root).generic_string();
+        file.Hash = ResourceID(file.Path.c_str()).Hash;
+        std::ifstream stream(entry.path(), std::ios::binary);
+        file.Data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        files.push_back(std::move(file));
+    }
+    // el juego busca por hash con búsqueda binaria
+    std::sort(files.begin(), files.end(), [](const PackFile &a, const PackFile &b) { return a.Hash < b.Hash; });
+    for (std::size_t i = 1; i < files.size(); ++i)
+    {
+        if (files[i].Hash == files[i - 1].Hash)
+        {
+            std::cout << "ERROR::PACKER: hash collision between " << files[i - 1].Path << " and " << files[i].Path << std::endl;
+            return 1;
+        }
+    }
+
+    PackHeader header;
+    std::memcpy(header.Magic, PACK_MAGIC, sizeof(header.Magic));
+    header.Version = PACK_VERSION;
+    header.EntryCount = static_cast<std::uint32_t>(files.size());
+    header.Reserved = 0;
+
+    // los datos empiezan tras el índice; cada archivo queda alineado a PACK_ALIGNMENT
+    std::vector<PackEntry> entries(files.size());
+    std::uint64_t offset = sizeof(PackHeader) + sizeof(PackEntry) * files.size();
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        offset = (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+        entries[i].Hash = files[i].Hash;
+        entries[i].Offset = offset;
+        entries[i].Size = files[i].Data.size();
+        offset += files[i].Data.size();
+    }
+
+    std::ofstream out(argv[1], std::ios::binary);
+    if (!out)
+    {
+        std::cout << "ERROR::PACKER: could not open " << argv[1] << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), sizeof(PackEntry) * entries.size());
+    std::uint64_t written = sizeof(PackHeader) + sizeof(PackEntry) * entries.size();
+    const char padding[PACK_ALIGNMENT] = { };
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        out.write(padding, static_cast<std::streamsize>(entries[i].Offset - written));
+        out.write(reinterpret_cast<const char*>(files[i].Data.data()), static_cast<std::streamsize>(files[i].Data.size()));
+        written = entries[i].Offset + files[i].Data.size();
+        std::cout << files[i].Path << " (" << files[i].Data.size() << " bytes)" << std::endl;
+    }
+    std::cout << "PACKER: " << files.size() << " files, " << written << " bytes -> " << argv[1] << std::endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+// Mide pruebas círculo-caja por segundo con BoxBatch (SoA + SIMD, distancias al cuadrado) frente
+// a la prueba escalar que usaba DoCollisions, con 64, 1k, 10k y 100k cajas en rejilla.
+// Uso: collision_benchmark [consultas]
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "box_batch.h"
+
+// CheckCollision y VectorDirection de game.cpp antes del paso a BoxBatch: raíz en cada prueba
+// y una normalización por cada dirección de la brújula en cada choque
+struct Box {
+    glm::vec2 Position, Size;
+};
+
+static int vectorDirection(glm::vec2 target)
+{
+    glm::vec2 compass[] = { glm::vec2(0.0f, 1.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, -1.0f), glm::vec2(-1.0f, 0.0f) };
+    float max = 0.0f;
+    int best_match = -1;
+    for (int i = 0; i < 4; i++)
+    {
+        float dot_product = glm::dot(glm::normalize(target), compass[i]);
+        if (dot_product > max)
+        {
+            max = dot_product;
+            best_match = i;
+        }
+    }
+    return best_match;
+}
+
+static bool checkCollision(glm::vec2 center, float radius, const Box &box, int &direction)
+{
+    glm::vec2 aabb_half_extents(box.Size.x / 2.0f, box.Size.y / 2.0f);
+    glm::vec2 aabb_center(box.Position + aabb_half_extents);
+    glm::vec2 closest = aabb_center + glm::clamp(center - aabb_center, -aabb_half_extents, aabb_half_extents);
+    glm::vec2 difference = closest - center;
+    if (glm::length(difference) < radius)
+    {
+        direction = vectorDirection(difference);
+        return true;
+    }
+    return false;
+}
+
+// cajas de 40x20 en filas de 32, como los ladrillos de un nivel ancho
+static void buildBoxes(unsigned int amount, std::vector<Box> &boxes, BoxBatch &batch)
+{
+    boxes.clear();
+    batch.Clear();
+    for (unsigned int i = 0; i < amount; ++i)
+    {
+        Box box = { glm::vec2((i % 32) * 40.0f, (i / 32) * 20.0f), glm::vec2(40.0f, 20.0f) };
+        boxes.push_back(box);
+        batch.Add(box.Position, box.Size);
+    }
+}
+
+static std::vector<glm::vec2> randomCenters(unsigned int queries, unsigned int amount)
+{
+    std::vector<glm::vec2> centers(queries);
+    float height = ((amount + 31) / 32) * 20.0f;
+    for (glm::vec2 &center : centers)
+        center = glm::vec2((std::rand() % 12800) / 10.0f, (std::rand() % 1000) / 1000.0f * height);
+    return centers;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int queries = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 2000;
+    const float radius = 12.5f;
+    std::cout << "kernel: " << BoxBatch::Kernel() << ", " << queries << " queries" << std::endl;
+    std::vector<Box> boxes;
+    BoxBatch batch;
+    std::vector<std::uint32_t> hits;
+    for (unsigned int amount : { 64u, 1000u, 10000u, 100000u })
+    {
+        buildBoxes(amount, boxes, batch);
+        std::vector<glm::vec2> centers = randomCenters(queries, amount);
+        // recorrido escalar
+        unsigned long long scalarHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (glm::vec2 center : centers)
+        {
+            int direction;
+            for (const Box &box : boxes)
+                if (checkCollision(center, radius, box, direction))
+                    ++scalarHits;
+        }
+        double scalar = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // recorrido por lotes
+        unsigned long long batchHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (glm::vec2 center : centers)
+        {
+            glm::vec2 normal;
+            batch.Test(center, radius, hits, normal);
+            for (std::uint32_t word : hits)
+                for (; word; word &= word - 1)
+                    ++batchHits;
+        }
+        double batched = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double tests = static_cast<double>(amount) * queries;
+        std::cout << amount << " boxes: scalar " << tests / scalar / 1e6 << " M/s, batch " << tests / batched / 1e6
+                  << " M/s (x" << scalar / batched << "), hits " << scalarHits << " / " << batchHits << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Hornea una fuente a un tamaño y modo en un archivo .font (baked_font.h) que TextRenderer
+// carga sin FreeType. Incluye ASCII imprimible y Latin-1 (¡, ¿, vocales con tilde, ñ...).
+// Uso: font_baker <fuente.ttf> <tamaño> <bitmap|sdf> [lado del atlas]
+// La salida va junto a la fuente, con el nombre que busca TextRenderer (BakedFontPath).
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "baked_font.h"
+#include "glyph_rasterizer.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 4 || argc > 5 || (std::strcmp(argv[3], "bitmap") != 0 && std::strcmp(argv[3], "sdf") != 0))
+    {
+        std::cout << "usage: font_baker <font.ttf> <size> <bitmap|sdf> [atlas size]" << std::endl;
+        return 1;
+    }
+    std::string font = argv[1];
+    unsigned int fontSize = static_cast<unsigned int>(std::atoi(argv[2]));
+    TextMode mode = std::strcmp(argv[3], "sdf") == 0 ? TEXT_SDF : TEXT_BITMAP;
+    unsigned int atlasSize = argc == 5 ? static_cast<unsigned int>(std::atoi(argv[4])) : GLYPH_ATLAS_SIZE;
+
+    std::ifstream stream(font, std::ios::binary);
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    GlyphRasterizer rasterizer;
+    if (data.empty() || !rasterizer.Open(data.data(), data.size(), fontSize, mode))
+    {
+        std::cout << "ERROR::BAKER: could not open " << font << std::endl;
+        return 1;
+    }
+    unsigned int columns = atlasSize / rasterizer.CellWidth;
+    unsigned int cells = columns * (atlasSize / rasterizer.CellHeight);
+
+    std::vector<unsigned int> codepoints;
+    for (unsigned int c = 32; c < 127; ++c)
+        codepoints.push_back(c);
+    for (unsigned int c = 0xA1; c <= 0xFF; ++c)
+        codepoints.push_back(c);
+    if (codepoints.size() > cells)
+    {
+        std::cout << "ERROR::BAKER: " << codepoints.size() << " glyphs do not fit in " << cells << " cells of a " << atlasSize << "px atlas" << std::endl;
+        return 1;
+    }
+
+    // mismo reparto en celdas que TextRenderer: la celda i está en (i % columns, i / columns)
+    std::vector<unsigned char> atlas(atlasSize * atlasSize, 0);
+    std::vector<BakedGlyph> glyphs;
+    for (unsigned int codepoint : codepoints)
+    {
+        GlyphBitmap bitmap;
+        if (!rasterizer.Rasterize(codepoint, bitmap))
+            continue;
+        BakedGlyph glyph;
+        glyph.Codepoint = codepoint;
+        glyph.Cell = static_cast<std::uint32_t>(glyphs.size());
+        glyph.Width = std::min(bitmap.Width, static_cast<int>(rasterizer.CellWidth) - 1);
+        glyph.Height = std::min(bitmap.Height, static_cast<int>(rasterizer.CellHeight) - 1);
+        glyph.BearingX = bitmap.Bearing.x;
+        glyph.BearingY = bitmap.Bearing.y;
+        glyph.Advance = bitmap.Advance;
+        unsigned int x = (glyph.Cell % columns) * rasterizer.CellWidth;
+        unsigned int y = (glyph.Cell / columns) * rasterizer.CellHeight;
+        for (int row = 0; row < glyph.Height; ++row)
+            std::memcpy(&atlas[(y + row) * atlasSize + x], bitmap.Pixels + row * bitmap.Pitch, glyph.Width);
+        glyphs.push_back(glyph);
+    }
+
+    BakedFontHeader header;
+    std::memcpy(header.Magic, BAKED_FONT_MAGIC, sizeof(header.Magic));
+    header.Version = BAKED_FONT_VERSION;
+    header.Mode = static_cast<std::uint32_t>(mode);
+    header.FontSize = fontSize;
+    header.AtlasSize = atlasSize;
+    header.CellWidth = rasterizer.CellWidth;
+    header.CellHeight = rasterizer.CellHeight;
+    header.GlyphCount = static_cast<std::uint32_t>(glyphs.size());
+
+    std::string output = BakedFontPath(font, fontSize, mode);
+    std::ofstream out(output, std::ios::binary);
+    if (!out)
+    {
+        std::cout << "ERROR::BAKER: could not open " << output << std::endl;
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(glyphs.data()), sizeof(BakedGlyph) * glyphs.size());
+    out.write(reinterpret_cast<const char*>(atlas.data()), atlas.size());
+    std::cout << "BAKER: " << glyphs.size() << " glyphs of " << font << " at " << fontSize << "px (" << argv[3] << ") -> " << output << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Mide partículas actualizadas por segundo con ParticleBuffer (SoA + SIMD) frente al
+// recorrido anterior de structs intercalados, a 10k, 100k y 1M partículas.
+// Uso: particle_benchmark [frames]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "particle_buffer.h"
+
+// Disposición y bucle de ParticleGenerator antes del paso a SoA (sin el desvanecimiento,
+// que ahora hace particle.vs, para comparar el mismo trabajo)
+struct Particle {
+    glm::vec2 Position, Velocity;
+    glm::vec4 Color;
+    float     Life;
+};
+
+static float randomLife()
+{
+    return 0.5f + (std::rand() % 1000) / 1000.0f;
+}
+
+// Simula frames con el formato antiguo; las muertas reaparecen para mantener la carga constante
+static double benchmarkAoS(unsigned int amount, unsigned int frames, float dt)
+{
+    std::vector<Particle> particles(amount);
+    for (Particle &p : particles)
+        p = { glm::vec2(0.0f), glm::vec2(1.0f, 2.0f), glm::vec4(1.0f), randomLife() };
+    unsigned long long updated = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int frame = 0; frame < frames; ++frame)
+    {
+        for (Particle &p : particles)
+        {
+            p.Life -= dt;
+            if (p.Life > 0.0f)
+            {
+                p.Position -= p.Velocity * dt;
+                ++updated;
+            }
+            else
+                p = { glm::vec2(0.0f), glm::vec2(1.0f, 2.0f), glm::vec4(1.0f), randomLife() };
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return updated / seconds;
+}
+
+static double benchmarkSoA(unsigned int amount, unsigned int frames, float dt)
+{
+    ParticleBuffer particles(amount);
+    unsigned long long updated = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int frame = 0; frame < frames; ++frame)
+    {
+        while (particles.Count() < particles.Capacity())
+        {
+            unsigned int i = particles.Spawn();
+            particles.PositionX[i] = particles.PositionY[i] = 0.0f;
+            particles.VelocityX[i] = 1.0f;
+            particles.VelocityY[i] = 2.0f;
+            particles.ColorR[i] = particles.ColorG[i] = particles.ColorB[i] = particles.ColorA[i] = 1.0f;
+            particles.Life[i] = randomLife();
+            particles.Tag[i] = 0.0f;
+        }
+        updated += particles.Count();
+        particles.Update(dt);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return updated / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int frames = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 200;
+    const float dt = 1.0f / 60.0f;
+    std::cout << "kernel: " << ParticleBuffer::Kernel() << ", " << frames << " frames" << std::endl;
+    for (unsigned int amount : { 10000u, 100000u, 1000000u })
+    {
+        double aos = benchmarkAoS(amount, frames, dt);
+        double soa = benchmarkSoA(amount, frames, dt);
+        std::cout << amount << " particles: AoS " << aos / 1e6 << " M/s, SoA " << soa / 1e6
+                  << " M/s (x" << soa / aos << ")" << std::endl;
+    }
+    return 0;
+}